@@ -1,20 +1,58 @@
 APPS = binstats
 
-binstats_version = 1.4.1
-binstats_version_date = 2023-04-22
+binstats_version = 1.5.0
+binstats_version_date = 2026-10-16
 binstats_author = Daniel Starke
 
 CPPFLAGS += '-DBINSTATS_VERSION="$(binstats_version) ($(binstats_version_date))"' '-DBINSTATS_AUTHOR="$(binstats_author)"'
 
 binstats_obj = \
+	libpcf/arfile \
+	libpcf/elfsym \
 	libpcf/fdio \
 	libpcf/fdios \
 	libpcf/fdious \
+	libpcf/mfile \
+	libpcf/nmline \
+	libpcf/spsc \
+	libpcf/strsearch \
+	libpcf/thread \
+	libpcf/wildcard \
+	pcf/gui/Demangler \
 	pcf/gui/DroppableReadOnlyInput \
+	pcf/gui/FileWatcher \
+	pcf/gui/LazyDemangler \
+	pcf/gui/StringPool \
+	pcf/gui/SymbolCache \
+	pcf/gui/SymbolList \
+	pcf/gui/SymbolLoader \
+	pcf/gui/SymbolQuery \
 	pcf/gui/SymbolViewer \
+	pcf/gui/TrigramIndex \
+	pcf/gui/TypeBuckets \
 	pcf/gui/Utility \
+	pcf/gui/WorkerPool \
 	binstats
 
+BENCHES = spawn nmparse wildcard
+
+bench_spawn_obj = \
+	libpcf/fdio \
+	libpcf/fdios \
+	libpcf/thread \
+	bench/spawn
+
+bench_nmparse_obj = \
+	libpcf/nmline \
+	libpcf/thread \
+	bench/nmparse
+
+bench_wildcard_obj = \
+	libpcf/strsearch \
+	libpcf/thread \
+	libpcf/wildcard \
+	bench/wildcard
+
 binstats_lib = \
 	libfltk \
 	libgdi32 \
@@ -25,6 +63,9 @@ binstats_lib = \
 
 all: $(DSTDIR) $(LIBDIR) $(INCDIR) $(addprefix $(DSTDIR)/,$(addsuffix $(BINEXT),$(APPS)))
 
+.PHONY: bench
+bench: $(DSTDIR) $(addprefix $(DSTDIR)/bench/,$(addsuffix $(BINEXT),$(BENCHES)))
+
 .PHONY: $(DSTDIR)
 $(DSTDIR):
 	mkdir -p $(DSTDIR)
@@ -53,6 +94,15 @@ $(DSTDIR)/binstats$(BINEXT): $(addprefix $(DSTDIR)/,$(addsuffix $(OBJEXT),$(bins
 	$(AR) rs $(DSTDIR)/binstats.a $+
 	$(LD) $(LDFLAGS) -mwindows -o $@ $(DSTDIR)/binstats.a $(binstats_lib:lib%=-l%)
 
+$(DSTDIR)/bench/spawn$(BINEXT): $(addprefix $(DSTDIR)/,$(addsuffix $(OBJEXT),$(bench_spawn_obj)))
+	$(LD) $(LDFLAGS) -o $@ $+
+
+$(DSTDIR)/bench/nmparse$(BINEXT): $(addprefix $(DSTDIR)/,$(addsuffix $(OBJEXT),$(bench_nmparse_obj)))
+	$(LD) $(LDFLAGS) -o $@ $+
+
+$(DSTDIR)/bench/wildcard$(BINEXT): $(addprefix $(DSTDIR)/,$(addsuffix $(OBJEXT),$(bench_wildcard_obj)))
+	$(LD) $(LDFLAGS) -o $@ $+
+
 $(DSTDIR)/%$(OBJEXT): $(SRCDIR)/%$(CEXT)
 	mkdir -p "$(dir $@)"
 	$(CC) $(CWFLAGS) $(CPPFLAGS) $(CFLAGS) -o $@ -c $<
@@ -67,13 +117,82 @@ $(SRCDIR)/license.hpp: $(DOCDIR)/COPYING $(SCRIPTDIR)/convert-license.sh
 # dependencies
 $(DSTDIR)/binstats$(OBJEXT): \
 	$(SRCDIR)/pcf/gui/DroppableReadOnlyInput.hpp \
+	$(SRCDIR)/pcf/gui/StringPool.hpp \
+	$(SRCDIR)/pcf/gui/SymbolList.hpp \
 	$(SRCDIR)/pcf/gui/SymbolViewer.hpp \
 	$(SRCDIR)/pcf/gui/Utility.hpp \
 	$(SRCDIR)/pcf/Utility.hpp \
 	$(SRCDIR)/binstats.hpp
+$(DSTDIR)/pcf/gui/Demangler$(OBJEXT): \
+	$(SRCDIR)/pcf/gui/Demangler.hpp \
+	$(SRCDIR)/pcf/gui/StringPool.hpp \
+	$(SRCDIR)/pcf/gui/SymbolList.hpp \
+	$(SRCDIR)/pcf/Utility.hpp
+$(DSTDIR)/pcf/gui/FileWatcher$(OBJEXT): \
+	$(SRCDIR)/pcf/gui/FileWatcher.hpp
+$(DSTDIR)/pcf/gui/LazyDemangler$(OBJEXT): \
+	$(SRCDIR)/pcf/gui/Demangler.hpp \
+	$(SRCDIR)/pcf/gui/LazyDemangler.hpp \
+	$(SRCDIR)/pcf/gui/StringPool.hpp \
+	$(SRCDIR)/pcf/gui/SymbolList.hpp \
+	$(SRCDIR)/pcf/gui/Utility.hpp \
+	$(SRCDIR)/pcf/Utility.hpp
+$(DSTDIR)/pcf/gui/StringPool$(OBJEXT): \
+	$(SRCDIR)/pcf/gui/StringPool.hpp \
+	$(SRCDIR)/pcf/Utility.hpp
+$(DSTDIR)/pcf/gui/SymbolCache$(OBJEXT): \
+	$(SRCDIR)/pcf/gui/DroppableReadOnlyInput.hpp \
+	$(SRCDIR)/pcf/gui/StringPool.hpp \
+	$(SRCDIR)/pcf/gui/SymbolCache.hpp \
+	$(SRCDIR)/pcf/gui/SymbolList.hpp \
+	$(SRCDIR)/pcf/gui/SymbolViewer.hpp \
+	$(SRCDIR)/pcf/gui/Utility.hpp \
+	$(SRCDIR)/pcf/Utility.hpp
+$(DSTDIR)/pcf/gui/SymbolList$(OBJEXT): \
+	$(SRCDIR)/pcf/gui/StringPool.hpp \
+	$(SRCDIR)/pcf/gui/SymbolList.hpp \
+	$(SRCDIR)/pcf/Utility.hpp
+$(DSTDIR)/pcf/gui/SymbolLoader$(OBJEXT): \
+	$(SRCDIR)/pcf/gui/Demangler.hpp \
+	$(SRCDIR)/pcf/gui/DroppableReadOnlyInput.hpp \
+	$(SRCDIR)/pcf/gui/StringPool.hpp \
+	$(SRCDIR)/pcf/gui/SymbolCache.hpp \
+	$(SRCDIR)/pcf/gui/SymbolList.hpp \
+	$(SRCDIR)/pcf/gui/SymbolLoader.hpp \
+	$(SRCDIR)/pcf/gui/SymbolViewer.hpp \
+	$(SRCDIR)/pcf/gui/Utility.hpp \
+	$(SRCDIR)/pcf/Utility.hpp
+$(DSTDIR)/pcf/gui/SymbolQuery$(OBJEXT): \
+	$(SRCDIR)/pcf/gui/StringPool.hpp \
+	$(SRCDIR)/pcf/gui/SymbolList.hpp \
+	$(SRCDIR)/pcf/gui/SymbolQuery.hpp \
+	$(SRCDIR)/pcf/Utility.hpp
 $(DSTDIR)/pcf/gui/SymbolViewer$(OBJEXT): \
+	$(SRCDIR)/pcf/gui/Demangler.hpp \
 	$(SRCDIR)/pcf/gui/DroppableReadOnlyInput.hpp \
+	$(SRCDIR)/pcf/gui/FileWatcher.hpp \
+	$(SRCDIR)/pcf/gui/LazyDemangler.hpp \
+	$(SRCDIR)/pcf/gui/StringPool.hpp \
+	$(SRCDIR)/pcf/gui/SymbolCache.hpp \
+	$(SRCDIR)/pcf/gui/SymbolList.hpp \
+	$(SRCDIR)/pcf/gui/SymbolLoader.hpp \
+	$(SRCDIR)/pcf/gui/SymbolQuery.hpp \
 	$(SRCDIR)/pcf/gui/SymbolViewer.hpp \
+	$(SRCDIR)/pcf/gui/TrigramIndex.hpp \
+	$(SRCDIR)/pcf/gui/TypeBuckets.hpp \
 	$(SRCDIR)/pcf/gui/Utility.hpp \
+	$(SRCDIR)/pcf/gui/WorkerPool.hpp \
 	$(SRCDIR)/pcf/Utility.hpp \
 	$(SRCDIR)/license.hpp
+$(DSTDIR)/pcf/gui/TrigramIndex$(OBJEXT): \
+	$(SRCDIR)/pcf/gui/StringPool.hpp \
+	$(SRCDIR)/pcf/gui/SymbolList.hpp \
+	$(SRCDIR)/pcf/gui/TrigramIndex.hpp \
+	$(SRCDIR)/pcf/Utility.hpp
+$(DSTDIR)/pcf/gui/TypeBuckets$(OBJEXT): \
+	$(SRCDIR)/pcf/gui/StringPool.hpp \
+	$(SRCDIR)/pcf/gui/SymbolList.hpp \
+	$(SRCDIR)/pcf/gui/TypeBuckets.hpp \
+	$(SRCDIR)/pcf/Utility.hpp
+$(DSTDIR)/pcf/gui/WorkerPool$(OBJEXT): \
+	$(SRCDIR)/pcf/gui/WorkerPool.hpp
@@ -0,0 +1,236 @@
+/**
+ * @file nmparse.c
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ * @remarks Measures the throughput of nmline_parse() on synthetic nm output
+ * (nm -S --size-sort -f bsd -t d) compared to the previous strtoll() based
+ * parser. Both parsers need to produce the same results.
+ * @remarks nmparse [lines [rounds]]
+ */
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <libpcf/nmline.h>
+#include <libpcf/thread.h>
+
+
+/** Default number of synthetic nm output lines. */
+#define DEFAULT_LINES 1000000
+/** Default number of parse rounds per parser. */
+#define DEFAULT_ROUNDS 10
+
+
+/**
+ * Checksum over all parsed fields to compare the parser results.
+ */
+typedef struct tResult {
+	unsigned long long symbols;
+	unsigned long long members;
+	unsigned long long hash;
+} tResult;
+
+
+/**
+ * Adds the given symbol or member to the result.
+ *
+ * @param[in,out] res - result to update
+ * @param[in] size - symbol size
+ * @param[in] type - symbol type or 0 for members
+ * @param[in] name - name
+ * @param[in] len - name length
+ * @internal
+ */
+static void addResult(tResult * res, const long long size, const char type, const char * name, const size_t len) {
+	size_t i;
+	unsigned long long hash = res->hash ^ (unsigned long long)size;
+	hash = (hash ^ (unsigned char)type) * 0x100000001B3ULL;
+	for (i = 0; i < len; i++) hash = (hash ^ (unsigned char)name[i]) * 0x100000001B3ULL;
+	res->hash = hash;
+	if (type != 0) {
+		res->symbols++;
+	} else {
+		res->members++;
+	}
+}
+
+
+/**
+ * Creates synthetic nm output lines. Each line is null-terminated as passed
+ * to the parser stage. Contains archive member headers, negative sizes,
+ * unknown types and names with spaces.
+ *
+ * @param[in] lines - number of lines
+ * @param[out] size - size of the returned buffer in bytes
+ * @return newly allocated buffer or NULL on error
+ * @internal
+ */
+static char * createInput(const size_t lines, size_t * size) {
+	static const char types[] = "TtDdBbRrWwVvUu?";
+	static const char * names[] = {
+		"main",
+		"_ZN3pcf3gui12SymbolViewer6updateEv",
+		"_ZNSt6vectorIN3pcf3gui12SymbolViewer6SymbolESaIS3_EE17_M_realloc_insertIJS3_EEEvN9__gnu_cxx17__normal_iteratorIPS3_S5_EEDpOT_",
+		"__libc_csu_init",
+		"operator new(unsigned long)",
+		"_ZL10hexDigit.lto_priv.0"
+	};
+	const size_t capacity = lines * 192;
+	char * buffer = (char *)malloc(capacity);
+	size_t pos = 0;
+	size_t i;
+	unsigned long long rnd = 0x9E3779B97F4A7C15ULL;
+	if (buffer == NULL) return NULL;
+	for (i = 0; i < lines; i++) {
+		int len;
+		rnd = (rnd * 6364136223846793005ULL) + 1442695040888963407ULL;
+		if ((i % 1000) == 0) {
+			len = sprintf(buffer + pos, "member%u.o:", (unsigned)(i / 1000));
+		} else {
+			const long long symSize = ((rnd >> 60) == 0) ? -(long long)((rnd >> 40) & 0xFF) : (long long)((rnd >> 33) & 0xFFFFF);
+			len = sprintf(buffer + pos, "%llu %lld %c %s%u", (rnd >> 16) & 0xFFFFFFFFFFULL, symSize, types[(rnd >> 8) % (sizeof(types) - 1)], names[(rnd >> 24) % (sizeof(names) / sizeof(*names))], (unsigned)i);
+		}
+		pos += (size_t)len + 1;
+	}
+	*size = pos;
+	return buffer;
+}
+
+
+/**
+ * Parses the given lines like the previous strtoll() based parser.
+ *
+ * @param[in,out] text - null-terminated lines
+ * @param[in] size - text size in bytes
+ * @param[out] res - parse result
+ * @internal
+ */
+static void parseLegacy(char * text, const size_t size, tResult * res) {
+	const char * textEnd = text + size;
+	char * line;
+	for (line = text; line < textEnd; line += strlen(line) + 1) {
+		const size_t len = strlen(line);
+		char * next = NULL;
+		char * name;
+		long long value, symSize;
+		char type;
+		value = strtoll(line, &next, 10);
+		if (value == 0 && *next != ' ') {
+			if (line[len - 1] == ':' && len > 1) {
+				line[len - 1] = 0;
+				name = strdup(line);
+				line[len - 1] = ':';
+				addResult(res, 0, 0, name, len - 1);
+				free(name);
+			}
+			continue;
+		}
+		next++;
+		symSize = strtoll(next, &next, 10);
+		if (symSize == 0 && *next != ' ') continue;
+		next++;
+		type = *next;
+		next++;
+		if ((!isalpha(type) && type != '?') || *next != ' ') continue;
+		next++;
+		name = strdup(next);
+		addResult(res, symSize, type, name, strlen(name));
+		free(name);
+	}
+}
+
+
+/**
+ * Parses the given lines via nmline_parse().
+ *
+ * @param[in] text - null-terminated lines
+ * @param[in] size - text size in bytes
+ * @param[out] res - parse result
+ * @internal
+ */
+static void parseNmLine(const char * text, const size_t size, tResult * res) {
+	const char * textEnd = text + size;
+	const char * line;
+	tNmLine fields;
+	for (line = text; line < textEnd; ) {
+		const size_t len = strlen(line);
+		char * name;
+		switch (nmline_parse(line, len, 10, &fields)) {
+		case NMLINE_SYMBOL:
+			name = (char *)malloc(fields.nameLen + 1);
+			if (name == NULL) break;
+			memcpy(name, fields.name, fields.nameLen + 1);
+			addResult(res, fields.size, fields.type, name, fields.nameLen);
+			free(name);
+			break;
+		case NMLINE_MEMBER:
+			name = (char *)malloc(fields.nameLen + 1);
+			if (name == NULL) break;
+			memcpy(name, fields.name, fields.nameLen);
+			name[fields.nameLen] = 0;
+			addResult(res, 0, 0, name, fields.nameLen);
+			free(name);
+			break;
+		default:
+			break;
+		}
+		line += len + 1;
+	}
+}
+
+
+int main(int argc, char ** argv) {
+	size_t lines = DEFAULT_LINES;
+	size_t rounds = DEFAULT_ROUNDS;
+	size_t size, i;
+	char * text;
+	tResult legacy, parsed;
+	uint64_t start, legacyMs, parsedMs;
+	
+	if (argc > 1) {
+		lines = (size_t)strtoul(argv[1], NULL, 10);
+		if (lines == 0) lines = DEFAULT_LINES;
+	}
+	if (argc > 2) {
+		rounds = (size_t)strtoul(argv[2], NULL, 10);
+		if (rounds == 0) rounds = DEFAULT_ROUNDS;
+	}
+	
+	text = createInput(lines, &size);
+	if (text == NULL) {
+		fprintf(stderr, "Error: Failed to allocate input buffer.\n");
+		return EXIT_FAILURE;
+	}
+	
+	start = thread_ticks();
+	for (i = 0; i < rounds; i++) {
+		memset(&legacy, 0, sizeof(legacy));
+		parseLegacy(text, size, &legacy);
+	}
+	legacyMs = thread_ticks() - start;
+	
+	start = thread_ticks();
+	for (i = 0; i < rounds; i++) {
+		memset(&parsed, 0, sizeof(parsed));
+		parseNmLine(text, size, &parsed);
+	}
+	parsedMs = thread_ticks() - start;
+	
+	if (legacy.symbols != parsed.symbols || legacy.members != parsed.members || legacy.hash != parsed.hash) {
+		fprintf(stderr, "Error: Parser results differ.\n");
+		free(text);
+		return EXIT_FAILURE;
+	}
+	
+	if (legacyMs == 0) legacyMs = 1;
+	if (parsedMs == 0) parsedMs = 1;
+	printf("%u lines (%.1f MiB), %u symbols, %u members, %u rounds\n", (unsigned)lines, (double)size / 1048576.0, (unsigned)parsed.symbols, (unsigned)parsed.members, (unsigned)rounds);
+	printf("%-12s %12s %12s\n", "parser", "MiB/s", "Mlines/s");
+	printf("%-12s %12.1f %12.2f\n", "strtoll", ((double)size * (double)rounds * 1000.0) / ((double)legacyMs * 1048576.0), ((double)lines * (double)rounds) / ((double)legacyMs * 1000.0));
+	printf("%-12s %12.1f %12.2f\n", "nmline", ((double)size * (double)rounds * 1000.0) / ((double)parsedMs * 1048576.0), ((double)lines * (double)rounds) / ((double)parsedMs * 1000.0));
+	
+	free(text);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file spawn.c
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ * @remarks Measures the start-up latency of fdios_popen() depending on the
+ * resident memory of the calling process. The posix_spawn() fast path is
+ * compared with the fork() fall-back (FDIO_USE_FORK).
+ * @remarks spawn [count [program [arguments ...]]]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <libpcf/fdios.h>
+#include <libpcf/thread.h>
+
+
+/** Default number of processes started per measurement. */
+#define DEFAULT_COUNT 200
+
+
+/**
+ * Starts the given program count times and waits for each to finish.
+ *
+ * @param[in] argv - program and arguments
+ * @param[in] count - number of processes to start
+ * @param[in] mode - additional tFdioPMode flags
+ * @return average latency in microseconds or -1.0 on error
+ */
+static double measure(const char ** argv, const size_t count, const int mode) {
+	char buffer[256];
+	size_t i;
+	const uint64_t start = thread_ticks();
+	for (i = 0; i < count; i++) {
+		tFdioPHandle * child = fdios_popen(argv[0], argv, NULL, NULL, (tFdioPMode)(FDIO_USE_STDOUT | FDIO_COMBINE | mode));
+		if (child == NULL) return -1.0;
+		while (fread(buffer, 1, sizeof(buffer), child->out) > 0);
+		fdios_pclose(child);
+	}
+	return ((double)(thread_ticks() - start) * 1000.0) / (double)count;
+}
+
+
+int main(int argc, char ** argv) {
+	static const size_t rssMiB[] = {0, 64, 256, 1024};
+#ifdef PCF_IS_WIN
+	static const char * defaultArgv[] = {"cmd.exe", "/c", "exit", NULL};
+#else /* ! PCF_IS_WIN */
+	static const char * defaultArgv[] = {"true", NULL};
+#endif /* PCF_IS_WIN */
+	const char ** childArgv = defaultArgv;
+	size_t count = DEFAULT_COUNT;
+	size_t i;
+	char * heap = NULL;
+	
+	if (argc > 1) {
+		count = (size_t)strtoul(argv[1], NULL, 10);
+		if (count == 0) count = DEFAULT_COUNT;
+	}
+	if (argc > 2) childArgv = (const char **)(argv + 2);
+	
+	printf("%10s %12s %12s\n", "RSS [MiB]", "spawn [us]", "fork [us]");
+	for (i = 0; i < (sizeof(rssMiB) / sizeof(*rssMiB)); i++) {
+		const size_t size = rssMiB[i] << 20;
+		double spawnUs, forkUs;
+		if (heap != NULL) free(heap);
+		heap = NULL;
+		if (size > 0) {
+			heap = (char *)malloc(size);
+			if (heap == NULL) {
+				fprintf(stderr, "Error: Failed to allocate %u MiB.\n", (unsigned)rssMiB[i]);
+				break;
+			}
+			/* make the memory resident */
+			memset(heap, (int)i, size);
+		}
+		spawnUs = measure(childArgv, count, 0);
+		forkUs = measure(childArgv, count, FDIO_USE_FORK);
+		if (spawnUs < 0.0 || forkUs < 0.0) {
+			fprintf(stderr, "Error: Failed to start \"%s\".\n", childArgv[0]);
+			break;
+		}
+		printf("%10u %12.1f %12.1f\n", (unsigned)rssMiB[i], spawnUs, forkUs);
+	}
+	if (heap != NULL) free(heap);
+	return 0;
+}
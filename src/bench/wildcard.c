@@ -0,0 +1,257 @@
+/**
+ * @file wildcard.c
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ * @remarks Measures the compiled wildcard matcher (wildcard_match()) compared
+ * to the previous pattern interpreter on synthetic demangled template names.
+ * Pathological patterns with many '*' are included. Both matchers need to
+ * produce the same results.
+ * @remarks wildcard [names [rounds]]
+ */
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <libpcf/thread.h>
+#include <libpcf/wildcard.h>
+
+
+/** Default number of synthetic symbol names. */
+#define DEFAULT_NAMES 200000
+/** Default number of match rounds per matcher and pattern. */
+#define DEFAULT_ROUNDS 5
+
+
+/** Patterns to measure. */
+static const char * patterns[] = {
+	"*a*a*a*b",
+	"*a*a*a*a*a*a*a*z",
+	"*?*?*?*?*?*?*!",
+	"std::*vector<*>::*",
+	"*Symbol*update*",
+	"*allocator<char>*#*",
+	"pcf::gui::*",
+	"*::operator()*"
+};
+
+
+/**
+ * Creates synthetic demangled symbol names. The names are stored as
+ * consecutive null-terminated strings.
+ *
+ * @param[in] count - number of names
+ * @param[out] size - size of the returned buffer in bytes
+ * @return newly allocated buffer or NULL on error
+ * @internal
+ */
+static char * createNames(const size_t count, size_t * size) {
+	static const char * scopes[] = {"std::", "pcf::gui::", "boost::detail::", "__gnu_cxx::", ""};
+	static const char * templates[] = {
+		"vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > >",
+		"map<unsigned long, std::pair<pcf::gui::SymbolViewer::Statistics, std::vector<int, std::allocator<int> > >, std::less<unsigned long>, std::allocator<std::pair<unsigned long const, int> > >",
+		"_Rb_tree_iterator<std::pair<std::basic_string<char, std::char_traits<char>, std::allocator<char> > const, pcf::gui::SymbolList*> >",
+		"ListView<pcf::gui::SymbolViewer::SymbolRow, 4ul, pcf::gui::SymbolViewer::ViewContext>",
+		"SymbolViewer"
+	};
+	static const char * members[] = {"::_M_realloc_insert", "::operator()", "::update", "::~", "::aaaaaaaaaaaaaaaa"};
+	const size_t capacity = count * 512;
+	char * buffer = (char *)malloc(capacity);
+	size_t pos = 0;
+	size_t i;
+	unsigned long long rnd = 0x9E3779B97F4A7C15ULL;
+	if (buffer == NULL) return NULL;
+	for (i = 0; i < count; i++) {
+		int len;
+		rnd = (rnd * 6364136223846793005ULL) + 1442695040888963407ULL;
+		len = sprintf(buffer + pos, "%s%s%s<%u>(unsigned long)", scopes[(rnd >> 16) % 5], templates[(rnd >> 24) % 5], members[(rnd >> 32) % 5], (unsigned)i);
+		pos += (size_t)len + 1;
+	}
+	*size = pos;
+	return buffer;
+}
+
+
+/**
+ * Returns 1 if text matches pattern, else 0. This is the previous pattern
+ * interpreter which is kept as reference.
+ *
+ * @param[in] text - text string
+ * @param[in] pattern - wildcard matching string
+ * @return 1 on match, else 0
+ * @internal
+ */
+static int matchLegacy(const char * text, const char * pattern) {
+	const char * curText; /* current text */
+	const char * curPat; /* current pattern */
+	const char * laText; /* look ahead text */
+	const char * laPat; /* look ahead pattern */
+	const char * sPat; /* saved pattern */
+	if (text == NULL || pattern == NULL) return 0;
+	curText = text;
+	curPat = pattern;
+	do {
+		switch (*curPat) {
+		case '*':
+			laText = curText;
+			laPat = curPat + 1;
+			if (*laPat == 0) return 1;
+			if (*laText == 0) {
+				curPat = laPat;
+				continue;
+			}
+			sPat = laPat;
+			while (*sPat == '*') {
+				curPat = sPat;
+				sPat++;
+			}
+			if (*sPat == *curText || *sPat == '?' || (*sPat == '#' && isdigit((unsigned char)*curText))) {
+				laPat = sPat;
+				while (*laPat != '*' && *laPat != 0) {
+					if (*laText == *laPat || *laPat == '?' || (*laPat == '#' && isdigit((unsigned char)*laText))) {
+						laText++;
+						laPat++;
+					} else {
+						curText++;
+						break;
+					}
+					if (*laText == 0) {
+						while (*laPat == '*') {
+							laPat++;
+						}
+						if (*laPat == 0) {
+							return 1;
+						} else {
+							curText++;
+							break;
+						}
+					}
+				}
+				if (*laPat == '*') {
+					curText = laText;
+					sPat = laPat;
+				} else {
+					if (*laText == *laPat && *laPat == 0) {
+						/* this point will never be reached (see previous return) */
+						return 1;
+					} else if (*laText == 0) {
+						continue;
+					} else if (*laPat == 0) {
+						curText++;
+						sPat = curPat;
+					} else {
+						sPat = curPat;
+					}
+				}
+				curPat = sPat;
+			} else {
+				curText++;
+			}
+			break;
+		case '?':
+			if (*curText != 0) {
+				curText++;
+				curPat++;
+				if (*curText != 0 && *curPat == 0) {
+					return 0;
+				}
+			} else {
+				return 0;
+			}
+			break;
+		case '#':
+			if ( isdigit((unsigned char)*curText) ) {
+				curText++;
+				curPat++;
+				if (*curText != 0 && *curPat == 0) {
+					return 0;
+				}
+			} else {
+				return 0;
+			}
+			break;
+		default:
+			if (*curText == *curPat) {
+				curText++;
+				curPat++;
+			} else {
+				return 0;
+			}
+			break;
+		}
+	} while (*curPat != 0);
+	if (*curText != 0) return 0;
+	return 1;
+}
+
+
+int main(int argc, char ** argv) {
+	size_t count = DEFAULT_NAMES;
+	size_t rounds = DEFAULT_ROUNDS;
+	size_t size, p, i;
+	char * names;
+	const char * textEnd;
+	const char * name;
+	
+	if (argc > 1) {
+		count = (size_t)strtoul(argv[1], NULL, 10);
+		if (count == 0) count = DEFAULT_NAMES;
+	}
+	if (argc > 2) {
+		rounds = (size_t)strtoul(argv[2], NULL, 10);
+		if (rounds == 0) rounds = DEFAULT_ROUNDS;
+	}
+	
+	names = createNames(count, &size);
+	if (names == NULL) {
+		fprintf(stderr, "Error: Failed to allocate input buffer.\n");
+		return EXIT_FAILURE;
+	}
+	textEnd = names + size;
+	
+	printf("%u names (%.1f MiB), %u rounds\n", (unsigned)count, (double)size / 1048576.0, (unsigned)rounds);
+	printf("%-24s %10s %12s %12s %10s\n", "pattern", "matches", "legacy ms", "compiled ms", "speedup");
+	for (p = 0; p < (sizeof(patterns) / sizeof(*patterns)); p++) {
+		size_t legacyMatches = 0, compiledMatches = 0;
+		uint64_t start, legacyMs, compiledMs;
+		tWildcard * wc;
+		
+		start = thread_ticks();
+		for (i = 0; i < rounds; i++) {
+			for (name = names; name < textEnd; name += strlen(name) + 1) {
+				legacyMatches += (size_t)matchLegacy(name, patterns[p]);
+			}
+		}
+		legacyMs = thread_ticks() - start;
+		
+		start = thread_ticks();
+		for (i = 0; i < rounds; i++) {
+			/* compiled once per search like SymbolViewer::update() */
+			wc = wildcard_create(patterns[p], 0);
+			if (wc == NULL) {
+				fprintf(stderr, "Error: Failed to compile pattern.\n");
+				free(names);
+				return EXIT_FAILURE;
+			}
+			for (name = names; name < textEnd; name += strlen(name) + 1) {
+				compiledMatches += (size_t)wildcard_match(wc, name);
+			}
+			wildcard_free(wc);
+		}
+		compiledMs = thread_ticks() - start;
+		
+		if (legacyMatches != compiledMatches) {
+			fprintf(stderr, "Error: Matcher results differ for \"%s\".\n", patterns[p]);
+			free(names);
+			return EXIT_FAILURE;
+		}
+		
+		if (legacyMs == 0) legacyMs = 1;
+		if (compiledMs == 0) compiledMs = 1;
+		printf("%-24s %10u %12u %12u %9.1fx\n", patterns[p], (unsigned)(compiledMatches / rounds), (unsigned)legacyMs, (unsigned)compiledMs, (double)legacyMs / (double)compiledMs);
+	}
+	
+	free(names);
+	return EXIT_SUCCESS;
+}
@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2017-2023 Daniel Starke
  * @date 2017-12-01
- * @version 2023-04-21
+ * @version 2026-10-16
  */
 #include <FL/fl_ask.H>
 #include <pcf/gui/SymbolViewer.hpp>
@@ -16,6 +16,7 @@ int wmain() {
 #else
 int main() {
 #endif
+	Fl::lock(); /* enable multi-threading support */
 	Fl::visual(FL_DOUBLE | FL_RGB);
 	Fl::set_color(FL_BACKGROUND_COLOR, 212, 208, 200);
 	Fl::set_labeltype(FL_NO_SYMBOL_LABEL, pcf::gui::noSymLabelDraw, pcf::gui::noSymLabelMeasure);
@@ -0,0 +1,213 @@
+/**
+ * @file arfile.c
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @see arfile.h
+ * @date 2026-10-16
+ * @version 2026-10-16
+ * @remarks Supports the GNU/SysV and BSD variants of the common ar format.
+ * @see https://en.wikipedia.org/wiki/Ar_(Unix)
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <libpcf/arfile.h>
+
+
+/** Archive file signature. */
+#define AR_MAGIC "!<arch>\n"
+/** Archive file signature length. */
+#define AR_MAGIC_LEN 8
+/** Archive member header length. */
+#define AR_HDR_LEN 60
+
+
+/**
+ * Parses a space padded decimal number of the given length.
+ *
+ * @param[in] str - string to parse
+ * @param[in] len - maximum length of str
+ * @param[out] value - parsed value
+ * @return 1 on success, else 0
+ * @internal
+ */
+static int parseDec(const char * str, const size_t len, size_t * value) {
+	size_t i, res = 0;
+	int hasDigits = 0;
+	for (i = 0; i < len && str[i] >= '0' && str[i] <= '9'; i++) {
+		res = (res * 10) + (size_t)(str[i] - '0');
+		hasDigits = 1;
+	}
+	for (; i < len; i++) {
+		if (str[i] != ' ') return 0;
+	}
+	*value = res;
+	return hasDigits;
+}
+
+
+/**
+ * Reads a big endian number of the given byte width.
+ *
+ * @internal
+ */
+static size_t readBE(const unsigned char * ptr, const size_t width) {
+	size_t i, res = 0;
+	for (i = 0; i < width; i++) res = (res << 8) | ptr[i];
+	return res;
+}
+
+
+/**
+ * Returns the number of symbols listed in the given archive symbol map.
+ *
+ * @param[in] name - member name field
+ * @param[in] data - symbol map content
+ * @param[in] size - symbol map size in bytes
+ * @return number of symbols or 0 if this is no symbol map
+ * @internal
+ */
+static size_t armapSymbols(const char * name, const unsigned char * data, const size_t size) {
+	if (memcmp(name, "/               ", 16) == 0) {
+		/* GNU/SysV 32-bit */
+		return (size >= 4) ? readBE(data, 4) : 0;
+	}
+	if (memcmp(name, "/SYM64/         ", 16) == 0) {
+		/* GNU/SysV 64-bit */
+		return (size >= 8) ? readBE(data, 8) : 0;
+	}
+	if (memcmp(name, "__.SYMDEF", 9) == 0 || (memcmp(name, "#1/", 3) == 0 && size >= 9 && memcmp(data, "__.SYMDEF", 9) == 0)) {
+		/* BSD (ranlib structures in host byte order) */
+		uint32_t ranlibSize;
+		size_t off = 0;
+		if (name[0] == '#' && parseDec(name + 3, 13, &off) == 0) return 0;
+		if (size < (off + 4)) return 0;
+		memcpy(&ranlibSize, data + off, sizeof(ranlibSize));
+		return (size_t)(ranlibSize / 8);
+	}
+	return 0;
+}
+
+
+/**
+ * Checks whether the given data is an archive supported by arfile_index().
+ * Thin archives are not supported as their members are stored externally.
+ *
+ * @param[in] data - file content
+ * @param[in] size - file size in bytes
+ * @return 1 if supported, else 0
+ */
+int arfile_isArchive(const void * data, const size_t size) {
+	if (data == NULL || size < AR_MAGIC_LEN) return 0;
+	return memcmp(data, AR_MAGIC, AR_MAGIC_LEN) == 0;
+}
+
+
+/**
+ * Creates an index of all regular members of the given archive. The symbol
+ * map and the long name table are not reported as members. Only the member
+ * headers are visited; the member content is not touched.
+ *
+ * @param[in] data - file content
+ * @param[in] size - file size in bytes
+ * @return NULL on error or the archive index
+ * @see arfile_free()
+ */
+tArIndex * arfile_index(const void * data, const size_t size) {
+	const unsigned char * ptr = (const unsigned char *)data;
+	const char * longNames = NULL;
+	size_t longNamesSize = 0;
+	size_t pos, capacity = 0;
+	tArIndex * index;
+
+	if (arfile_isArchive(data, size) == 0) return NULL;
+	index = (tArIndex *)calloc(1, sizeof(tArIndex));
+	if (index == NULL) return NULL;
+
+	for (pos = AR_MAGIC_LEN; (pos + AR_HDR_LEN) <= size; ) {
+		const char * hdr = (const char *)(ptr + pos);
+		const unsigned char * memberData = ptr + pos + AR_HDR_LEN;
+		size_t memberSize, nameLen, nameOff = 0;
+		const char * name;
+		char * nameCopy;
+		if (hdr[58] != '`' || hdr[59] != '\n') goto onError;
+		if (parseDec(hdr + 48, 10, &memberSize) == 0) goto onError;
+		if (memberSize > (size - pos - AR_HDR_LEN)) goto onError;
+		pos += AR_HDR_LEN + memberSize + (memberSize & 1);
+
+		/* special members */
+		if (index->symbols == 0) {
+			const size_t symbols = armapSymbols(hdr, memberData, memberSize);
+			if (symbols > 0) {
+				index->symbols = symbols;
+				continue;
+			}
+		}
+		if (memcmp(hdr, "/               ", 16) == 0 || memcmp(hdr, "/SYM64/         ", 16) == 0) continue;
+		if (memcmp(hdr, "//              ", 16) == 0) {
+			longNames = (const char *)memberData;
+			longNamesSize = memberSize;
+			continue;
+		}
+
+		/* resolve member name */
+		if (hdr[0] == '/' && hdr[1] >= '0' && hdr[1] <= '9') {
+			/* GNU/SysV long name */
+			if (longNames == NULL || parseDec(hdr + 1, 15, &nameOff) == 0 || nameOff >= longNamesSize) goto onError;
+			name = longNames + nameOff;
+			for (nameLen = 0; (nameOff + nameLen) < longNamesSize && name[nameLen] != '\n'; nameLen++);
+			if (nameLen > 0 && name[nameLen - 1] == '/') nameLen--;
+		} else if (memcmp(hdr, "#1/", 3) == 0) {
+			/* BSD long name stored in front of the member data */
+			if (parseDec(hdr + 3, 13, &nameLen) == 0 || nameLen > memberSize) goto onError;
+			name = (const char *)memberData;
+			memberData += nameLen;
+			memberSize -= nameLen;
+			while (nameLen > 0 && name[nameLen - 1] == 0) nameLen--;
+			if (nameLen >= 9 && memcmp(name, "__.SYMDEF", 9) == 0) continue;
+		} else {
+			/* short name */
+			name = hdr;
+			for (nameLen = 16; nameLen > 0 && name[nameLen - 1] == ' '; nameLen--);
+			if (nameLen > 0 && name[nameLen - 1] == '/') nameLen--;
+			if (nameLen >= 9 && memcmp(name, "__.SYMDEF", 9) == 0) continue;
+		}
+
+		/* add member */
+		if (index->count >= capacity) {
+			tArMember * newMembers;
+			capacity = (capacity > 0) ? (capacity * 2) : 64;
+			newMembers = (tArMember *)realloc(index->members, sizeof(tArMember) * capacity);
+			if (newMembers == NULL) goto onError;
+			index->members = newMembers;
+		}
+		nameCopy = (char *)malloc(sizeof(char) * (nameLen + 1));
+		if (nameCopy == NULL) goto onError;
+		memcpy(nameCopy, name, sizeof(char) * nameLen);
+		nameCopy[nameLen] = 0;
+		index->members[index->count].name = nameCopy;
+		index->members[index->count].data = memberData;
+		index->members[index->count].size = memberSize;
+		index->count++;
+	}
+
+	return index;
+onError:
+	arfile_free(index);
+	return NULL;
+}
+
+
+/**
+ * Frees the given archive index.
+ *
+ * @param[in,out] index - index from arfile_index()
+ */
+void arfile_free(tArIndex * index) {
+	size_t i;
+	if (index == NULL) return;
+	if (index->members != NULL) {
+		for (i = 0; i < index->count; i++) free(index->members[i].name);
+		free(index->members);
+	}
+	free(index);
+}
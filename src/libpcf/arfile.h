@@ -0,0 +1,60 @@
+/**
+ * @file arfile.h
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @see arfile.c
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __LIBPCF_ARFILE_H__
+#define __LIBPCF_ARFILE_H__
+
+#include <stddef.h>
+#include <libpcf/target.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef LIBPCF_DECL
+#define LIBPCF_DECL
+#endif /* LIBPCF_DECL */
+
+#ifndef LIBPCF_DLLPORT
+#define LIBPCF_DLLPORT
+#endif /* LIBPCF_DLLPORT */
+
+
+/**
+ * Defines a single archive member as reported by arfile_index().
+ */
+typedef struct tArMember {
+	char * name; /**< null-terminated member name */
+	const void * data; /**< member content (points into the passed archive data) */
+	size_t size; /**< member size in bytes */
+} tArMember;
+
+
+/**
+ * Defines the member index of an archive.
+ */
+typedef struct tArIndex {
+	tArMember * members; /**< archive members in file order */
+	size_t count; /**< number of archive members */
+	size_t symbols; /**< number of global symbols in the archive symbol map (0 if none) */
+} tArIndex;
+
+
+LIBPCF_DLLPORT int LIBPCF_DECL arfile_isArchive(const void * data, const size_t size);
+LIBPCF_DLLPORT tArIndex * LIBPCF_DECL arfile_index(const void * data, const size_t size);
+LIBPCF_DLLPORT void LIBPCF_DECL arfile_free(tArIndex * index);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* __LIBPCF_ARFILE_H__ */
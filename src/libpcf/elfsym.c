@@ -0,0 +1,447 @@
+/**
+ * @file elfsym.c
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @see elfsym.h
+ * @date 2026-10-16
+ * @version 2026-10-16
+ * @remarks Symbol types are derived the same way as bfd_decode_symclass() in binutils does.
+ * @see https://refspecs.linuxfoundation.org/elf/gabi4+/ch4.symtab.html
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <libpcf/elfsym.h>
+
+
+/* ELF constants (see elf.h, which is not available on every target) */
+#define EI_NIDENT 16
+#define EI_CLASS 4
+#define EI_DATA 5
+#define ELFCLASS32 1
+#define ELFCLASS64 2
+#define ELFDATA2LSB 1
+#define ELFDATA2MSB 2
+#define SHT_SYMTAB 2
+#define SHT_NOTE 7
+#define SHT_NOBITS 8
+#define SHT_DYNSYM 11
+#define SHT_SYMTAB_SHNDX 18
+#define SHF_WRITE 0x1
+#define SHF_ALLOC 0x2
+#define SHF_EXECINSTR 0x4
+#define SHN_UNDEF 0
+#define SHN_LORESERVE 0xFF00
+#define SHN_ABS 0xFFF1
+#define SHN_COMMON 0xFFF2
+#define SHN_XINDEX 0xFFFF
+#define STB_LOCAL 0
+#define STB_GLOBAL 1
+#define STB_WEAK 2
+#define STB_GNU_UNIQUE 10
+#define STT_OBJECT 1
+#define STT_SECTION 3
+#define STT_FILE 4
+#define STT_GNU_IFUNC 10
+#define NT_GNU_BUILD_ID 3
+
+
+/**
+ * Reader context for a single ELF file.
+ *
+ * @internal
+ */
+typedef struct tElfCtx {
+	const unsigned char * data; /**< file content */
+	size_t size; /**< file size in bytes */
+	int is64; /**< 1 for ELF64, 0 for ELF32 */
+	int swap; /**< 1 if the byte order differs from the host byte order */
+} tElfCtx;
+
+
+/**
+ * Section header fields needed to read the symbol tables.
+ *
+ * @internal
+ */
+typedef struct tElfSection {
+	uint32_t name;
+	uint32_t type;
+	uint64_t flags;
+	uint64_t offset;
+	uint64_t size;
+	uint32_t link;
+	uint64_t entsize;
+} tElfSection;
+
+
+static uint16_t rd16(const tElfCtx * ctx, const unsigned char * ptr) {
+	uint16_t res;
+	memcpy(&res, ptr, sizeof(res));
+	return (uint16_t)(ctx->swap ? ((res << 8) | (res >> 8)) : res);
+}
+
+
+static uint32_t rd32(const tElfCtx * ctx, const unsigned char * ptr) {
+	uint32_t res;
+	memcpy(&res, ptr, sizeof(res));
+	return ctx->swap ? PCF_BYTE_SWAP32(res) : res;
+}
+
+
+static uint64_t rd64(const tElfCtx * ctx, const unsigned char * ptr) {
+	uint64_t res;
+	memcpy(&res, ptr, sizeof(res));
+	return ctx->swap ? PCF_BYTE_SWAP64(res) : res;
+}
+
+
+/**
+ * Returns 1 if the given range lies within the file content, else 0.
+ *
+ * @internal
+ */
+static int inRange(const tElfCtx * ctx, const uint64_t offset, const uint64_t size) {
+	return offset <= (uint64_t)ctx->size && size <= ((uint64_t)ctx->size - offset);
+}
+
+
+/**
+ * Reads the section header at the given index.
+ *
+ * @internal
+ */
+static void readSection(const tElfCtx * ctx, const unsigned char * ptr, tElfSection * sec) {
+	if ( ctx->is64 ) {
+		sec->name    = rd32(ctx, ptr);
+		sec->type    = rd32(ctx, ptr + 4);
+		sec->flags   = rd64(ctx, ptr + 8);
+		sec->offset  = rd64(ctx, ptr + 24);
+		sec->size    = rd64(ctx, ptr + 32);
+		sec->link    = rd32(ctx, ptr + 40);
+		sec->entsize = rd64(ctx, ptr + 56);
+	} else {
+		sec->name    = rd32(ctx, ptr);
+		sec->type    = rd32(ctx, ptr + 4);
+		sec->flags   = rd32(ctx, ptr + 8);
+		sec->offset  = rd32(ctx, ptr + 16);
+		sec->size    = rd32(ctx, ptr + 20);
+		sec->link    = rd32(ctx, ptr + 24);
+		sec->entsize = rd32(ctx, ptr + 36);
+	}
+}
+
+
+/**
+ * Initializes the reader context for the given ELF file.
+ *
+ * @internal
+ */
+static void initContext(tElfCtx * ctx, const void * data, const size_t size) {
+	ctx->data = (const unsigned char *)data;
+	ctx->size = size;
+	ctx->is64 = (ctx->data[EI_CLASS] == ELFCLASS64);
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	ctx->swap = (ctx->data[EI_DATA] == ELFDATA2LSB);
+#else
+	ctx->swap = (ctx->data[EI_DATA] == ELFDATA2MSB);
+#endif
+}
+
+
+/**
+ * Locates the section headers. Extended section numbering is supported.
+ *
+ * @param[in] ctx - reader context
+ * @param[out] secHdrs - set to the first section header
+ * @param[out] shNum - set to the number of section headers
+ * @param[out] shEntSize - set to the size of a single section header
+ * @param[out] shStrIndex - set to the index of the section name string table
+ * @return 1 on success, else 0
+ * @internal
+ */
+static int locateSections(const tElfCtx * ctx, const unsigned char ** secHdrs, uint32_t * shNum, uint32_t * shEntSize, uint32_t * shStrIndex) {
+	tElfSection sec[1];
+	uint64_t shOff;
+	if ( ctx->is64 ) {
+		shOff = rd64(ctx, ctx->data + 40);
+		*shEntSize = rd16(ctx, ctx->data + 58);
+		*shNum = rd16(ctx, ctx->data + 60);
+		*shStrIndex = rd16(ctx, ctx->data + 62);
+	} else {
+		shOff = rd32(ctx, ctx->data + 32);
+		*shEntSize = rd16(ctx, ctx->data + 46);
+		*shNum = rd16(ctx, ctx->data + 48);
+		*shStrIndex = rd16(ctx, ctx->data + 50);
+	}
+	if (shOff == 0 || *shEntSize < (uint32_t)(ctx->is64 ? 64 : 40)) return 0;
+	if ( ! inRange(ctx, shOff, *shEntSize) ) return 0;
+	*secHdrs = ctx->data + shOff;
+	if (*shNum == 0 || *shStrIndex == SHN_XINDEX) {
+		/* extended section numbering */
+		readSection(ctx, *secHdrs, sec);
+		if (*shNum == 0) {
+			if (sec->size > UINT32_MAX) return 0;
+			*shNum = (uint32_t)sec->size;
+		}
+		if (*shStrIndex == SHN_XINDEX) *shStrIndex = sec->link;
+	}
+	return inRange(ctx, shOff, (uint64_t)(*shNum) * (*shEntSize));
+}
+
+
+/**
+ * Returns 1 if str starts with prefix, else 0.
+ *
+ * @internal
+ */
+static int startsWith(const char * str, const char * prefix) {
+	return strncmp(str, prefix, strlen(prefix)) == 0;
+}
+
+
+/**
+ * Derives the lower case nm type character for symbols of the given section.
+ * This mirrors coff_section_type() and decode_section_type() from binutils.
+ *
+ * @param[in] sec - section header
+ * @param[in] name - section name (may be NULL)
+ * @return type character
+ * @internal
+ */
+static char sectionType(const tElfSection * sec, const char * name) {
+	const int hasContents = (sec->type != SHT_NOBITS);
+	const int isReadOnly = ((sec->flags & SHF_WRITE) == 0);
+	const int isCode = ((sec->flags & SHF_EXECINSTR) != 0);
+	const int isAlloc = ((sec->flags & SHF_ALLOC) != 0);
+	const int isSmall = (name != NULL && (startsWith(name, ".sdata") || startsWith(name, ".sbss")));
+	if (name != NULL) {
+		if (strcmp(name, ".drectve") == 0) return 'i';
+		if (strcmp(name, ".edata") == 0) return 'e';
+		if (strcmp(name, ".idata") == 0) return 'i';
+		if (strcmp(name, ".pdata") == 0) return 'p';
+	}
+	if ( isCode ) return 't';
+	if (isAlloc && hasContents) {
+		if ( isReadOnly ) return 'r';
+		if ( isSmall ) return 'g';
+		return 'd';
+	}
+	if ( ! hasContents ) return isSmall ? 's' : 'b';
+	if (( ! isAlloc ) && name != NULL && (startsWith(name, ".debug") || startsWith(name, ".zdebug")
+		|| startsWith(name, ".gnu.linkonce.wi.") || startsWith(name, ".gnu.debuglto_.debug_")
+		|| startsWith(name, ".line") || startsWith(name, ".stab"))) {
+		return 'N';
+	}
+	if ( isReadOnly ) return 'n';
+	return '?';
+}
+
+
+/**
+ * Checks whether the given data is an ELF32 or ELF64 file supported by elfsym_read().
+ *
+ * @param[in] data - file content
+ * @param[in] size - file size in bytes
+ * @return 1 if supported, else 0
+ */
+int elfsym_isElf(const void * data, const size_t size) {
+	const unsigned char * ptr = (const unsigned char *)data;
+	if (ptr == NULL || size < EI_NIDENT) return 0;
+	if (ptr[0] != 0x7F || ptr[1] != 'E' || ptr[2] != 'L' || ptr[3] != 'F') return 0;
+	if (ptr[EI_CLASS] != ELFCLASS32 && ptr[EI_CLASS] != ELFCLASS64) return 0;
+	if (ptr[EI_DATA] != ELFDATA2LSB && ptr[EI_DATA] != ELFDATA2MSB) return 0;
+	return size >= (size_t)((ptr[EI_CLASS] == ELFCLASS64) ? 64 : 52);
+}
+
+
+/**
+ * Reads all defined symbols with a non-zero size from the symbol table of the
+ * given ELF file. This matches the output of nm -S --size-sort. The dynamic
+ * symbol table is used if no regular symbol table exists.
+ *
+ * @param[in] data - file content
+ * @param[in] size - file size in bytes
+ * @param[in] callback - called for each symbol found
+ * @param[in] param - user defined parameter passed to callback
+ * @return -1 on error or abort, else the number of symbols passed to callback
+ */
+long elfsym_read(const void * data, const size_t size, tElfSymCallback callback, void * param) {
+	tElfCtx ctx[1];
+	tElfSection sec[1], strSec[1], symSec[1], shndxSec[1];
+	const unsigned char * secHdrs;
+	const unsigned char * symPtr;
+	const char * shStrTab = NULL;
+	const char * strTab;
+	const unsigned char * shndxTab = NULL;
+	char * secTypes = NULL;
+	uint64_t shStrSize = 0, symCount, n;
+	uint32_t shNum, shStrIndex, shEntSize, i;
+	size_t symEntSize;
+	int hasSymTab = 0, hasShndx = 0;
+	long result = 0;
+	tElfSymbol sym;
+
+	if (callback == NULL || elfsym_isElf(data, size) == 0) return -1;
+	memset(symSec, 0, sizeof(symSec));
+	memset(shndxSec, 0, sizeof(shndxSec));
+	initContext(ctx, data, size);
+	if (locateSections(ctx, &secHdrs, &shNum, &shEntSize, &shStrIndex) == 0) return -1;
+
+	/* section name string table */
+	if (shStrIndex != SHN_UNDEF && shStrIndex < shNum) {
+		readSection(ctx, secHdrs + ((size_t)shStrIndex * shEntSize), sec);
+		if (sec->type != SHT_NOBITS && inRange(ctx, sec->offset, sec->size) && sec->size > 0) {
+			shStrTab = (const char *)(ctx->data + sec->offset);
+			shStrSize = sec->size;
+		}
+	}
+
+	/* find symbol table (prefer the static one) and derive the symbol type per section */
+	secTypes = (char *)malloc(sizeof(char) * (shNum + 1));
+	if (secTypes == NULL) return -1;
+	for (i = 0; i < shNum; i++) {
+		const char * name = NULL;
+		readSection(ctx, secHdrs + ((size_t)i * shEntSize), sec);
+		if (shStrTab != NULL && sec->name < shStrSize && memchr(shStrTab + sec->name, 0, (size_t)(shStrSize - sec->name)) != NULL) {
+			name = shStrTab + sec->name;
+		}
+		secTypes[i] = sectionType(sec, name);
+		if (sec->type == SHT_SYMTAB || (sec->type == SHT_DYNSYM && hasSymTab == 0)) {
+			*symSec = *sec;
+			hasSymTab = (sec->type == SHT_SYMTAB) ? 2 : 1;
+		}
+	}
+	if (hasSymTab == 0) goto onError;
+	/* extended section indices belonging to the selected symbol table */
+	for (i = 0; i < shNum; i++) {
+		readSection(ctx, secHdrs + ((size_t)i * shEntSize), sec);
+		if (sec->type != SHT_SYMTAB_SHNDX) continue;
+		if (sec->link >= shNum) continue;
+		readSection(ctx, secHdrs + ((size_t)sec->link * shEntSize), strSec);
+		if (strSec->type != symSec->type || strSec->offset != symSec->offset) continue;
+		if ( ! inRange(ctx, sec->offset, sec->size) ) continue;
+		*shndxSec = *sec;
+		shndxTab = ctx->data + sec->offset;
+		hasShndx = 1;
+		break;
+	}
+
+	/* symbol name string table */
+	if (symSec->link == SHN_UNDEF || symSec->link >= shNum) goto onError;
+	readSection(ctx, secHdrs + ((size_t)symSec->link * shEntSize), strSec);
+	if (strSec->type == SHT_NOBITS || ( ! inRange(ctx, strSec->offset, strSec->size) )) goto onError;
+	strTab = (const char *)(ctx->data + strSec->offset);
+
+	/* walk symbol table */
+	symEntSize = (size_t)(ctx->is64 ? 24 : 16);
+	if (symSec->entsize >= symEntSize) symEntSize = (size_t)symSec->entsize;
+	if ( ! inRange(ctx, symSec->offset, symSec->size) ) goto onError;
+	symCount = symSec->size / symEntSize;
+	symPtr = ctx->data + symSec->offset;
+	for (n = 1; n < symCount; n++) {
+		const unsigned char * ptr = symPtr + (n * symEntSize);
+		uint32_t nameOff, shndx;
+		unsigned char info, bind, type;
+		int isExtIndex = 0;
+		char c;
+		if ( ctx->is64 ) {
+			nameOff   = rd32(ctx, ptr);
+			info      = ptr[4];
+			shndx     = rd16(ctx, ptr + 6);
+			sym.value = rd64(ctx, ptr + 8);
+			sym.size  = rd64(ctx, ptr + 16);
+		} else {
+			nameOff   = rd32(ctx, ptr);
+			sym.value = rd32(ctx, ptr + 4);
+			sym.size  = rd32(ctx, ptr + 8);
+			info      = ptr[12];
+			shndx     = rd16(ctx, ptr + 14);
+		}
+		bind = (unsigned char)(info >> 4);
+		type = (unsigned char)(info & 0x0F);
+		/* nm skips debugger-only symbols by default and --size-sort drops undefined and empty ones */
+		if (type == STT_SECTION || type == STT_FILE) continue;
+		if (shndx == SHN_UNDEF || sym.size == 0) continue;
+		if (nameOff >= strSec->size) continue;
+		if (memchr(strTab + nameOff, 0, (size_t)(strSec->size - nameOff)) == NULL) continue;
+		sym.name = strTab + nameOff;
+		if (shndx == SHN_XINDEX && hasShndx != 0 && ((n + 1) * 4) <= shndxSec->size) {
+			shndx = rd32(ctx, shndxTab + (n * 4));
+			isExtIndex = 1;
+		}
+		/* derive nm symbol type */
+		if (shndx == SHN_COMMON) {
+			c = 'C';
+		} else if (type == STT_GNU_IFUNC) {
+			c = 'i';
+		} else if (bind == STB_WEAK) {
+			c = (type == STT_OBJECT) ? 'V' : 'W';
+		} else if (bind == STB_GNU_UNIQUE) {
+			c = 'u';
+		} else if (bind != STB_LOCAL && bind != STB_GLOBAL) {
+			c = '?';
+		} else {
+			if (shndx == SHN_ABS) {
+				c = 'a';
+			} else if (shndx < shNum && (shndx < SHN_LORESERVE || isExtIndex != 0)) {
+				c = secTypes[shndx];
+			} else {
+				c = '?';
+			}
+			if (bind == STB_GLOBAL) c = (char)toupper(c);
+		}
+		sym.type = c;
+		if (callback(&sym, param) == 0) goto onError;
+		result++;
+	}
+
+	free(secTypes);
+	return result;
+onError:
+	free(secTypes);
+	return -1;
+}
+
+
+/**
+ * Returns the GNU build ID of the given ELF file. The build ID is a hash over
+ * the relevant file content created by the linker (--build-id).
+ *
+ * @param[in] data - file content
+ * @param[in] size - file size in bytes
+ * @param[out] id - set to the build ID (points into the passed data)
+ * @param[out] len - set to the build ID length in bytes
+ * @return 1 on success, 0 if no build ID was found
+ */
+int elfsym_buildId(const void * data, const size_t size, const unsigned char ** id, size_t * len) {
+	tElfCtx ctx[1];
+	tElfSection sec[1];
+	const unsigned char * secHdrs;
+	uint32_t shNum, shStrIndex, shEntSize, i;
+
+	if (id == NULL || len == NULL || elfsym_isElf(data, size) == 0) return 0;
+	initContext(ctx, data, size);
+	if (locateSections(ctx, &secHdrs, &shNum, &shEntSize, &shStrIndex) == 0) return 0;
+	for (i = 0; i < shNum; i++) {
+		uint64_t pos;
+		readSection(ctx, secHdrs + ((size_t)i * shEntSize), sec);
+		if (sec->type != SHT_NOTE || ( ! inRange(ctx, sec->offset, sec->size) )) continue;
+		/* walk through all notes of this section (4 byte aligned name and descriptor) */
+		for (pos = 0; (pos + 12) <= sec->size; ) {
+			const unsigned char * note = ctx->data + sec->offset + pos;
+			const uint64_t nameSize = rd32(ctx, note);
+			const uint64_t descSize = rd32(ctx, note + 4);
+			const uint32_t type = rd32(ctx, note + 8);
+			const uint64_t descOff = 12 + ((nameSize + 3) & ~(uint64_t)3);
+			const uint64_t noteSize = descOff + ((descSize + 3) & ~(uint64_t)3);
+			if (noteSize > (sec->size - pos)) break;
+			if (type == NT_GNU_BUILD_ID && nameSize == 4 && memcmp(note + 12, "GNU", 4) == 0 && descSize > 0) {
+				*id = note + descOff;
+				*len = (size_t)descSize;
+				return 1;
+			}
+			pos += noteSize;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file elfsym.h
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @see elfsym.c
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __LIBPCF_ELFSYM_H__
+#define __LIBPCF_ELFSYM_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <libpcf/target.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef LIBPCF_DECL
+#define LIBPCF_DECL
+#endif /* LIBPCF_DECL */
+
+#ifndef LIBPCF_DLLPORT
+#define LIBPCF_DLLPORT
+#endif /* LIBPCF_DLLPORT */
+
+
+/**
+ * Defines a single symbol as reported by elfsym_read().
+ */
+typedef struct tElfSymbol {
+	const char * name; /**< null-terminated symbol name (points into the passed data) */
+	uint64_t value; /**< symbol value (usually the address) */
+	uint64_t size; /**< symbol size in bytes */
+	char type; /**< symbol type character as reported by nm */
+} tElfSymbol;
+
+
+/**
+ * Callback function type for elfsym_read().
+ *
+ * @param[in] sym - symbol found
+ * @param[in] param - user defined parameter
+ * @return 1 to continue, 0 to abort
+ */
+typedef int (*tElfSymCallback)(const tElfSymbol * sym, void * param);
+
+
+LIBPCF_DLLPORT int LIBPCF_DECL elfsym_isElf(const void * data, const size_t size);
+LIBPCF_DLLPORT long LIBPCF_DECL elfsym_read(const void * data, const size_t size, tElfSymCallback callback, void * param);
+LIBPCF_DLLPORT int LIBPCF_DECL elfsym_buildId(const void * data, const size_t size, const unsigned char ** id, size_t * len);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* __LIBPCF_ELFSYM_H__ */
@@ -4,7 +4,7 @@
  * @copyright Copyright 2015-2023 Daniel Starke
  * @see fdio.h
  * @date 2015-02-28
- * @version 2018-02-26
+ * @version 2026-10-16
  */
 #define _POSIX_C_SOURCE 200809L
 #include <stdlib.h>
@@ -19,6 +19,7 @@
 #include <errno.h>
 #include <dirent.h>
 #include <fcntl.h>
+#include <signal.h>
 #include <string.h>
 #include <unistd.h>
 #endif /* ! PCF_IS_WIN */
@@ -61,6 +62,24 @@ int fdio_setMode(FILE * fd, tFdioMode mode) {
 }
 
 
+/**
+ * Terminates the child process of the given fdios_popen or fdious_popen
+ * handle. The handle still needs to be closed via fdios_pclose or
+ * fdious_pclose afterwards.
+ *
+ * @param[in] fd - tFdioPHandle pointer to the process handle
+ * @return 1 on success, else 0
+ */
+int fdio_pkill(const tFdioPHandle * fd) {
+	if (fd == NULL) return 0;
+#ifdef PCF_IS_WIN
+	return (TerminateProcess(fd->pid, 1) != 0) ? 1 : 0;
+#else /* ! PCF_IS_WIN */
+	return (kill(fd->pid, SIGKILL) == 0) ? 1 : 0;
+#endif /* PCF_IS_WIN */
+}
+
+
 #ifdef PCF_IS_WIN
 /**
  * Global mutex to avoid handle inheritance when calling CreateProcess.
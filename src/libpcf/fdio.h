@@ -5,7 +5,7 @@
  * @see fdios.h
  * @see fdious.h
  * @date 2015-02-15
- * @version 2017-12-03
+ * @version 2026-10-16
  */
 #ifndef __LIBPCF_FDIO_H__
 #define __LIBPCF_FDIO_H__
@@ -60,7 +60,8 @@ typedef enum tFdioPMode {
 	FDIO_USE_STDERR  = 0x04, /**< open standard error of child process for reading */
 	FDIO_BINARY_PIPE = 0x08, /**< open pipes in binary mode */
 	FDIO_COMBINE     = 0x10, /**< merge standard error in standard output of child process */
-	FDIO_RAW_CMDLINE = 0x20  /**< do not escape command-line arguments (Windows only) */
+	FDIO_RAW_CMDLINE = 0x20, /**< do not escape command-line arguments (Windows only) */
+	FDIO_USE_FORK    = 0x40  /**< do not use the posix_spawn() fast path (POSIX only) */
 } tFdioPMode;
 
 
@@ -77,6 +78,7 @@ typedef enum tFdioMode {
 
 
 LIBPCF_DLLPORT int LIBPCF_DECL fdio_setMode(FILE * fd, tFdioMode mode);
+LIBPCF_DLLPORT int LIBPCF_DECL fdio_pkill(const tFdioPHandle * fd);
 
 
 #ifdef __cplusplus
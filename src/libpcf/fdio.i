@@ -5,7 +5,7 @@
  * @see fdios.h
  * @see fdious.h
  * @date 2016-08-17
- * @version 2018-02-27
+ * @version 2026-10-16
  * @internal This file is never used or compiled directly but only included.
  * @remarks Define CHAR_T to the character type before including this file.
  * @remarks See FPOPEN_FUNC() and FPCLOSE_FUNC() for further notes.
@@ -24,6 +24,7 @@
 #include <winbase.h>
 #else /* ! PCF_IS_WIN */
 #include <errno.h>
+#include <fcntl.h>
 #include <signal.h>
 #include <unistd.h>
 #ifdef FPOPEN_UNICODE
@@ -39,6 +40,24 @@
 #ifndef WRITE_PIPE
 #define WRITE_PIPE 1
 #endif
+#ifndef PIPE_BUFFER_SIZE
+/** Requested buffer size of the pipes which receive the output of the child process. */
+#define PIPE_BUFFER_SIZE 0x100000
+#endif
+#if !defined(PCF_IS_WIN) && !defined(F_SETPIPE_SZ) && defined(__linux__)
+/* hidden by _POSIX_C_SOURCE but available since Linux 2.6.35 */
+#define F_SETPIPE_SZ 1031
+#endif
+#if !defined(PCF_IS_WIN) && !defined(HAS_POSIX_SPAWN_CLOSEFROM) && defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 34))
+#define HAS_POSIX_SPAWN_CLOSEFROM 1
+#endif
+#ifdef HAS_POSIX_SPAWN_CLOSEFROM
+#include <spawn.h>
+#ifndef __USE_GNU
+/* hidden by _POSIX_C_SOURCE but available since glibc 2.34 */
+extern int posix_spawn_file_actions_addclosefrom_np(posix_spawn_file_actions_t * actions, int from);
+#endif /* __USE_GNU */
+#endif /* HAS_POSIX_SPAWN_CLOSEFROM */
 
 
 /**
@@ -59,6 +78,8 @@
  * @remarks Define FPOPEN_UNICODE for Unicode Windows build.
  * @remarks Windows implementation is based on https://msdn.microsoft.com/en-us/library/17w5ykft(v=vs.85).aspx
  * except if FDIO_RAW_CMDLINE is passed, which forces the function to pass the arguments separated by space.
+ * @remarks POSIX implementation uses posix_spawnp() if HAS_POSIX_SPAWN_CLOSEFROM is defined (automatically
+ * set for glibc 2.34 and newer) and FDIO_USE_FORK is not passed. fork() is used as fall-back.
  */
 
 
@@ -352,14 +373,14 @@ tFdioPHandle * FPOPEN_FUNC(const CHAR_T * shellPath, const CHAR_T ** shell, cons
 		hasPStdIn = 1;
 	}
 	if ((((int)mode) & FDIO_USE_STDOUT) != 0) {
-		if ( ! CreatePipe(&(pStandardOutput[READ_PIPE]), &(pStandardOutput[WRITE_PIPE]), &sa, 0 /* default buffer size */) ) {
+		if ( ! CreatePipe(&(pStandardOutput[READ_PIPE]), &(pStandardOutput[WRITE_PIPE]), &sa, PIPE_BUFFER_SIZE) ) {
 			goto onerror;
 		}
 		hasPStdOut = 1;
 	}
 	
 	if ((((int)mode) & FDIO_USE_STDERR) != 0 && (((int)mode) & FDIO_COMBINE) == 0) {
-		if ( ! CreatePipe(&(pStandardError[READ_PIPE]), &(pStandardError[WRITE_PIPE]), &sa, 0 /* default buffer size */) ) {
+		if ( ! CreatePipe(&(pStandardError[READ_PIPE]), &(pStandardError[WRITE_PIPE]), &sa, PIPE_BUFFER_SIZE) ) {
 			goto onerror;
 		}
 		hasPStdErr = 1;
@@ -604,6 +625,74 @@ int FPCLOSE_FUNC(tFdioPHandle * fd) {
 extern int fdio_closeNonDefFds();
 
 
+#ifdef HAS_POSIX_SPAWN_CLOSEFROM
+extern char ** environ;
+
+
+/**
+ * Starts the given program via posix_spawnp(). Unlike fork(), this does not
+ * copy the page tables of the calling process (glibc uses clone() with
+ * CLONE_VM and CLONE_VFORK) which keeps the start-up time independent of the
+ * memory used by the calling process. All file descriptors except for the
+ * standard ones are closed in the child process via close_range().
+ *
+ * @param[in] shellPath - path the shell binary
+ * @param[in] argv - command-line arguments
+ * @param[in] input - use this for the standard input of the new process (optional)
+ * @param[in] mode - open mode, see tFdioPMode
+ * @param[in] pStandardInput - standard input pipe
+ * @param[in] pStandardOutput - standard output pipe
+ * @param[in] pStandardError - standard error pipe
+ * @return -1 on error or the process ID of the child process
+ * @internal
+ */
+static pid_t spawnProcess(const CHAR_T * shellPath, CHAR_T ** argv, FILE * input, const tFdioPMode mode, const int * pStandardInput, const int * pStandardOutput, const int * pStandardError) {
+	posix_spawn_file_actions_t actions;
+	posix_spawnattr_t attr;
+	sigset_t mask;
+	pid_t pid;
+	int ok = 1;
+	
+	if (posix_spawn_file_actions_init(&actions) != 0) return -1;
+	if (posix_spawnattr_init(&attr) != 0) {
+		posix_spawn_file_actions_destroy(&actions);
+		return -1;
+	}
+	
+	/* clear out signal handlers and keep the signal mask of the calling thread */
+	sigfillset(&mask);
+	if (posix_spawnattr_setsigdefault(&attr, &mask) != 0) ok = 0;
+	if (ok != 0 && pthread_sigmask(SIG_BLOCK, NULL, &mask) != 0) ok = 0;
+	if (ok != 0 && posix_spawnattr_setsigmask(&attr, &mask) != 0) ok = 0;
+	if (ok != 0 && posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK) != 0) ok = 0;
+	
+	/* set stdin/stdout/stderr accordingly */
+	if ((((int)mode) & FDIO_USE_STDIN) != 0) {
+		if (ok != 0 && posix_spawn_file_actions_adddup2(&actions, pStandardInput[READ_PIPE], STDIN_FILENO) != 0) ok = 0;
+	} else if (input != NULL) {
+		if (ok != 0 && posix_spawn_file_actions_adddup2(&actions, fileno(input), STDIN_FILENO) != 0) ok = 0;
+	}
+	if ((((int)mode) & FDIO_USE_STDOUT) != 0) {
+		if (ok != 0 && posix_spawn_file_actions_adddup2(&actions, pStandardOutput[WRITE_PIPE], STDOUT_FILENO) != 0) ok = 0;
+	}
+	if ((((int)mode) & FDIO_USE_STDERR) != 0 && (((int)mode) & FDIO_COMBINE) == 0) {
+		if (ok != 0 && posix_spawn_file_actions_adddup2(&actions, pStandardError[WRITE_PIPE], STDERR_FILENO) != 0) ok = 0;
+	} else if ((((int)mode) & FDIO_COMBINE) != 0) {
+		if (ok != 0 && posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO) != 0) ok = 0;
+	}
+	
+	/* close all unwanted file descriptors inherited from the parent process */
+	if (ok != 0 && posix_spawn_file_actions_addclosefrom_np(&actions, STDERR_FILENO + 1) != 0) ok = 0;
+	
+	if (ok == 0 || posix_spawnp(&pid, shellPath, &actions, &attr, argv, environ) != 0) pid = -1;
+	
+	posix_spawnattr_destroy(&attr);
+	posix_spawn_file_actions_destroy(&actions);
+	return pid;
+}
+#endif /* HAS_POSIX_SPAWN_CLOSEFROM */
+
+
 tFdioPHandle * FPOPEN_FUNC(const CHAR_T * shellPath, const char ** shell, const char * command, FILE * input, const tFdioPMode mode) {
 	int pStandardInput[2];
 	int pStandardOutput[2];
@@ -666,22 +755,38 @@ tFdioPHandle * FPOPEN_FUNC(const CHAR_T * shellPath, const char ** shell, const
 	}
 	if ((((int)mode) & FDIO_USE_STDOUT) != 0) {
 		if (pipe(pStandardOutput) != 0) goto onerror;
+#ifdef F_SETPIPE_SZ
+		/* enlarge the pipe buffer if the kernel allows it; failure is not fatal */
+		fcntl(pStandardOutput[READ_PIPE], F_SETPIPE_SZ, PIPE_BUFFER_SIZE);
+#endif /* F_SETPIPE_SZ */
 		hasPStdOut = 1;
 	}
 	if ((((int)mode) & FDIO_USE_STDERR) != 0 && (((int)mode) & FDIO_COMBINE) == 0) {
 		if (pipe(pStandardError) != 0) goto onerror;
+#ifdef F_SETPIPE_SZ
+		fcntl(pStandardError[READ_PIPE], F_SETPIPE_SZ, PIPE_BUFFER_SIZE);
+#endif /* F_SETPIPE_SZ */
 		hasPStdErr = 1;
 	}
 
 	if ((fd = (tFdioPHandle *)malloc(sizeof(tFdioPHandle))) == NULL) goto onerror;
 	
-	/* Temporary disable signal handling for calling thread to avoid unexpected signals between
-	 * fork() and execvp(). */
-	sigfillset(&newMask);
-	if (pthread_sigmask(SIG_SETMASK, &newMask, &oldMask) != 0) goto onerror;
-	hasOldMask = 1;
+	fd->pid = -1;
+#ifdef HAS_POSIX_SPAWN_CLOSEFROM
+	if ((((int)mode) & FDIO_USE_FORK) == 0) {
+		fd->pid = spawnProcess(shellPath, argv, input, mode, pStandardInput, pStandardOutput, pStandardError);
+	}
+#endif /* HAS_POSIX_SPAWN_CLOSEFROM */
 	
-	fd->pid = fork();
+	if (fd->pid == -1) {
+		/* Temporary disable signal handling for calling thread to avoid unexpected signals between
+		 * fork() and execvp(). */
+		sigfillset(&newMask);
+		if (pthread_sigmask(SIG_SETMASK, &newMask, &oldMask) != 0) goto onerror;
+		hasOldMask = 1;
+		
+		fd->pid = fork();
+	}
 
 	switch (fd->pid) {
 	case -1: /* fork failed */
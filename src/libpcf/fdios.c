@@ -4,7 +4,7 @@
  * @copyright Copyright 2016-2023 Daniel Starke
  * @see fdios.h
  * @date 2016-11-13
- * @version 2017-12-03
+ * @version 2026-10-16
  */
 #define _POSIX_C_SOURCE 200809L
 #include <stdlib.h>
@@ -12,6 +12,13 @@
 #include <string.h>
 #include <libpcf/fdios.h>
 
+#ifdef PCF_IS_WIN
+#include <io.h>
+#else /* ! PCF_IS_WIN */
+#include <errno.h>
+#include <unistd.h>
+#endif /* PCF_IS_WIN */
+
 
 /**
  * Defines the size with which a buffer will be increased.
@@ -19,6 +26,12 @@
 #define BUFFER_INC_SIZE 128
 
 
+/**
+ * Defines the default block size of the line reader.
+ */
+#define LINE_READER_BLOCK_SIZE 0x100000
+
+
 /**
  * The function reads a line and sets the passed string pointer.
  * New space is allocated if the string can not hold more characters.
@@ -78,6 +91,121 @@ int fdios_getline(char ** strPtr, int * lenPtr, FILE * fd) {
 }
 
 
+/**
+ * Creates a new line reader for the given file. The line reader reads large
+ * blocks directly from the underlying file descriptor. Therefore, fd shall not
+ * be read by other means while the line reader is in use.
+ *
+ * @param[in] fd - file to read from
+ * @param[in] blockSize - initial buffer size in bytes (0 for the default)
+ * @return NULL on error or the new line reader
+ * @see fdios_lineReaderFree()
+ */
+tFdiosLineReader * fdios_lineReaderCreate(FILE * fd, const size_t blockSize) {
+	tFdiosLineReader * lr;
+	if (fd == NULL) return NULL;
+	lr = (tFdiosLineReader *)malloc(sizeof(tFdiosLineReader));
+	if (lr == NULL) return NULL;
+	lr->fd = fileno(fd);
+	lr->size = (blockSize > 0) ? blockSize : LINE_READER_BLOCK_SIZE;
+	lr->buffer = (char *)malloc(sizeof(char) * (lr->size + 1));
+	if (lr->fd < 0 || lr->buffer == NULL) {
+		if (lr->buffer != NULL) free(lr->buffer);
+		free(lr);
+		return NULL;
+	}
+	lr->start = 0;
+	lr->end = 0;
+	lr->scan = 0;
+	lr->eof = 0;
+	return lr;
+}
+
+
+/**
+ * Returns the next line from the given line reader. The returned line points
+ * into the internal buffer and stays valid until the next call. Trailing line
+ * break characters are removed and the line is null-terminated.
+ *
+ * @param[in,out] lr - line reader
+ * @param[out] line - set to the start of the line
+ * @param[out] len - set to the length of the line in characters
+ * @return 1 if a line was read, 0 on end of file, -1 on error
+ */
+int fdios_lineReaderGet(tFdiosLineReader * lr, char ** line, size_t * len) {
+	char * lineStart, * lineEnd;
+	if (lr == NULL || line == NULL || len == NULL) return -1;
+	for (;;) {
+		/* search for the next line break within the buffered data */
+		if (lr->scan < lr->end) {
+			lineEnd = (char *)memchr(lr->buffer + lr->scan, '\n', lr->end - lr->scan);
+			if (lineEnd != NULL) {
+				lineStart = lr->buffer + lr->start;
+				lr->start = (size_t)(lineEnd - lr->buffer) + 1;
+				lr->scan = lr->start;
+				break;
+			}
+			lr->scan = lr->end;
+		}
+		if ( lr->eof ) {
+			if (lr->start >= lr->end) return 0;
+			/* last line without line break */
+			lineStart = lr->buffer + lr->start;
+			lineEnd = lr->buffer + lr->end;
+			lr->start = lr->end;
+			lr->scan = lr->end;
+			break;
+		}
+		/* move remaining data to the front and grow the buffer if needed */
+		if (lr->start > 0) {
+			memmove(lr->buffer, lr->buffer + lr->start, sizeof(char) * (lr->end - lr->start));
+			lr->end -= lr->start;
+			lr->scan -= lr->start;
+			lr->start = 0;
+		}
+		if (lr->end >= lr->size) {
+			char * newBuffer = (char *)realloc(lr->buffer, sizeof(char) * ((lr->size * 2) + 1));
+			if (newBuffer == NULL) return -1;
+			lr->buffer = newBuffer;
+			lr->size *= 2;
+		}
+		/* read next block */
+		{
+#ifdef PCF_IS_WIN
+			const int res = _read(lr->fd, lr->buffer + lr->end, (unsigned int)PCF_MIN(lr->size - lr->end, (size_t)0x7FFFFFFF));
+#else /* ! PCF_IS_WIN */
+			const ssize_t res = read(lr->fd, lr->buffer + lr->end, lr->size - lr->end);
+			if (res < 0 && errno == EINTR) continue;
+#endif /* PCF_IS_WIN */
+			if (res < 0) return -1;
+			if (res == 0) {
+				lr->eof = 1;
+			} else {
+				lr->end += (size_t)res;
+			}
+		}
+	}
+	/* remove trailing line break characters */
+	while (lineEnd > lineStart && (lineEnd[-1] == '\r' || lineEnd[-1] == '\n')) lineEnd--;
+	*lineEnd = 0;
+	*line = lineStart;
+	*len = (size_t)(lineEnd - lineStart);
+	return 1;
+}
+
+
+/**
+ * Frees the given line reader. The underlying file is not closed.
+ *
+ * @param[in,out] lr - line reader from fdios_lineReaderCreate()
+ */
+void fdios_lineReaderFree(tFdiosLineReader * lr) {
+	if (lr == NULL) return;
+	if (lr->buffer != NULL) free(lr->buffer);
+	free(lr);
+}
+
+
 #define FPOPEN_FUNC fdios_popen
 #define FPCLOSE_FUNC fdios_pclose
 #undef FPOPEN_UNICODE
@@ -4,7 +4,7 @@
  * @copyright Copyright 2013-2023 Daniel Starke
  * @see fdios.c
  * @date 2013-06-15
- * @version 2017-12-03
+ * @version 2026-10-16
  */
 #ifndef __LIBPCF_FDIOS_H__
 #define __LIBPCF_FDIOS_H__
@@ -27,7 +27,25 @@ extern "C" {
 #endif /* LIBPCF_DLLPORT */
 
 
+/**
+ * Defines a block buffered line reader.
+ * Create via fdios_lineReaderCreate() and read via fdios_lineReaderGet().
+ */
+typedef struct tFdiosLineReader {
+	int fd; /**< file descriptor to read from */
+	char * buffer; /**< read buffer (size + 1 characters) */
+	size_t size; /**< read buffer capacity in characters */
+	size_t start; /**< start of the unprocessed data in buffer */
+	size_t end; /**< end of the valid data in buffer */
+	size_t scan; /**< end of the data already searched for a line break */
+	int eof; /**< set to 1 after the end of file was reached */
+} tFdiosLineReader;
+
+
 LIBPCF_DLLPORT int LIBPCF_DECL fdios_getline(char ** strPtr, int * lenPtr, FILE * fd);
+LIBPCF_DLLPORT tFdiosLineReader * LIBPCF_DECL fdios_lineReaderCreate(FILE * fd, const size_t blockSize);
+LIBPCF_DLLPORT int LIBPCF_DECL fdios_lineReaderGet(tFdiosLineReader * lr, char ** line, size_t * len);
+LIBPCF_DLLPORT void LIBPCF_DECL fdios_lineReaderFree(tFdiosLineReader * lr);
 LIBPCF_DLLPORT tFdioPHandle * LIBPCF_DECL fdios_popen(const char * shellPath, const char ** shell, const char * command, FILE * input, const tFdioPMode mode);
 LIBPCF_DLLPORT int LIBPCF_DECL fdios_pclose(tFdioPHandle * fd);
 
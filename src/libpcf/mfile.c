@@ -0,0 +1,108 @@
+/**
+ * @file mfile.c
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @see mfile.h
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <libpcf/mfile.h>
+
+#ifndef PCF_IS_WIN
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif /* ! PCF_IS_WIN */
+
+
+/**
+ * Maps the given file read-only into memory.
+ * Empty files are not supported.
+ *
+ * @param[in] path - path to the file (UTF-8 encoded on Windows)
+ * @return NULL on error or the handle to the mapped file
+ * @see mfile_close()
+ */
+tMFile * mfile_open(const char * path) {
+	tMFile * mf;
+	if (path == NULL) return NULL;
+	mf = (tMFile *)malloc(sizeof(tMFile));
+	if (mf == NULL) return NULL;
+#ifdef PCF_IS_WIN
+	{
+		LARGE_INTEGER fileSize;
+		wchar_t * pathW;
+		const int pathWLen = MultiByteToWideChar(CP_UTF8, 0, path, -1, NULL, 0);
+		if (pathWLen <= 0) goto onError;
+		pathW = (wchar_t *)malloc(sizeof(wchar_t) * (size_t)pathWLen);
+		if (pathW == NULL) goto onError;
+		MultiByteToWideChar(CP_UTF8, 0, path, -1, pathW, pathWLen);
+		mf->file = CreateFileW(pathW, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		free(pathW);
+		if (mf->file == INVALID_HANDLE_VALUE) goto onError;
+		if (GetFileSizeEx(mf->file, &fileSize) == 0 || fileSize.QuadPart <= 0 || (unsigned long long)fileSize.QuadPart > (unsigned long long)((size_t)-1)) {
+			CloseHandle(mf->file);
+			goto onError;
+		}
+		mf->size = (size_t)fileSize.QuadPart;
+		mf->map = CreateFileMappingW(mf->file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mf->map == NULL) {
+			CloseHandle(mf->file);
+			goto onError;
+		}
+		mf->ptr = MapViewOfFile(mf->map, FILE_MAP_READ, 0, 0, 0);
+		if (mf->ptr == NULL) {
+			CloseHandle(mf->map);
+			CloseHandle(mf->file);
+			goto onError;
+		}
+	}
+#else /* ! PCF_IS_WIN */
+	{
+		struct stat fileInfo;
+		void * ptr;
+		mf->fd = open(path, O_RDONLY);
+		if (mf->fd < 0) goto onError;
+		if (fstat(mf->fd, &fileInfo) != 0 || fileInfo.st_size <= 0 || (unsigned long long)fileInfo.st_size > (unsigned long long)((size_t)-1)) {
+			close(mf->fd);
+			goto onError;
+		}
+		mf->size = (size_t)fileInfo.st_size;
+		ptr = mmap(NULL, mf->size, PROT_READ, MAP_PRIVATE, mf->fd, 0);
+		if (ptr == MAP_FAILED) {
+			close(mf->fd);
+			goto onError;
+		}
+#ifdef POSIX_MADV_WILLNEED
+		posix_madvise(ptr, mf->size, POSIX_MADV_WILLNEED);
+#endif /* POSIX_MADV_WILLNEED */
+		mf->ptr = ptr;
+	}
+#endif /* PCF_IS_WIN */
+	return mf;
+onError:
+	free(mf);
+	return NULL;
+}
+
+
+/**
+ * Unmaps the given file and frees the handle.
+ *
+ * @param[in,out] mf - handle from mfile_open()
+ */
+void mfile_close(tMFile * mf) {
+	if (mf == NULL) return;
+#ifdef PCF_IS_WIN
+	UnmapViewOfFile(mf->ptr);
+	CloseHandle(mf->map);
+	CloseHandle(mf->file);
+#else /* ! PCF_IS_WIN */
+	munmap((void *)mf->ptr, mf->size);
+	close(mf->fd);
+#endif /* PCF_IS_WIN */
+	free(mf);
+}
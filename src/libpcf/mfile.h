@@ -0,0 +1,58 @@
+/**
+ * @file mfile.h
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @see mfile.c
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __LIBPCF_MFILE_H__
+#define __LIBPCF_MFILE_H__
+
+#include <stddef.h>
+#include <libpcf/target.h>
+#ifdef PCF_IS_WIN
+#include <windows.h>
+#endif /* PCF_IS_WIN */
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef LIBPCF_DECL
+#define LIBPCF_DECL
+#endif /* LIBPCF_DECL */
+
+#ifndef LIBPCF_DLLPORT
+#define LIBPCF_DLLPORT
+#endif /* LIBPCF_DLLPORT */
+
+
+/**
+ * Defines a structure for a read-only memory mapped file.
+ * Access field ptr for the file content.
+ */
+typedef struct tMFile {
+	const void * ptr; /**< start of the mapped file content */
+	size_t size; /**< size of the mapped file content in bytes */
+#ifdef PCF_IS_WIN
+	HANDLE file; /**< handle of the underlying file */
+	HANDLE map; /**< handle of the file mapping object */
+#else /* ! PCF_IS_WIN */
+	int fd; /**< file descriptor of the underlying file */
+#endif /* PCF_IS_WIN */
+} tMFile;
+
+
+LIBPCF_DLLPORT tMFile * LIBPCF_DECL mfile_open(const char * path);
+LIBPCF_DLLPORT void LIBPCF_DECL mfile_close(tMFile * mf);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* __LIBPCF_MFILE_H__ */
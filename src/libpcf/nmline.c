@@ -0,0 +1,158 @@
+/**
+ * @file nmline.c
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @see nmline.h
+ * @date 2026-10-16
+ * @version 2026-10-16
+ * @remarks Parses nm output lines in BSD format with sizes (nm -S -f bsd):
+ * <value> <size> <type> <name>
+ */
+#include <stdint.h>
+#include <string.h>
+#include <libpcf/nmline.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define HAS_SSE2 1
+#endif
+
+
+/**
+ * Number of leading bytes which need to contain the value and size field
+ * separators. This fits two 64-bit numbers with sign in decimal notation.
+ */
+#define SCAN_SIZE 64
+
+
+/**
+ * Returns a bit mask with the positions of all space characters within the
+ * first SCAN_SIZE bytes of the given line.
+ *
+ * @param[in] line - line to scan
+ * @param[in] len - line length in bytes
+ * @return bit mask (bit n is set if line[n] is a space)
+ * @internal
+ */
+static uint64_t spaceMask(const char * line, const size_t len) {
+	uint64_t mask = 0;
+	size_t i = 0;
+	const size_t n = (len < SCAN_SIZE) ? len : SCAN_SIZE;
+#ifdef HAS_SSE2
+	const __m128i spaces = _mm_set1_epi8(' ');
+	for (; (i + 16) <= n; i += 16) {
+		const __m128i chunk = _mm_loadu_si128((const __m128i *)(line + i));
+		mask |= ((uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, spaces))) << i;
+		if (mask != 0 && (mask & (mask - 1)) != 0) return mask; /* found both separators */
+	}
+#endif /* HAS_SSE2 */
+	for (; i < n; i++) {
+		mask |= ((uint64_t)(line[i] == ' ')) << i;
+	}
+	return mask;
+}
+
+
+/**
+ * Maps characters to their hexadecimal digit value or 0xFF.
+ *
+ * @internal
+ */
+static const unsigned char hexDigit[256] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+
+/**
+ * Converts the given number field. An optional leading minus sign is
+ * accepted. The digits are validated once after the conversion loop.
+ *
+ * @param[in] ptr - start of the field
+ * @param[in] end - end of the field
+ * @param[in] radix - 10 or 16
+ * @param[out] out - converted value
+ * @return 1 on success, else 0
+ * @internal
+ */
+static int parseNumber(const char * ptr, const char * end, const int radix, long long * out) {
+	unsigned long long value = 0;
+	unsigned invalid = 0;
+	const int negative = (ptr < end && *ptr == '-');
+	ptr += negative;
+	if (ptr >= end) return 0;
+	if (radix == 16) {
+		for (; ptr < end; ptr++) {
+			const unsigned digit = hexDigit[(unsigned char)(*ptr)];
+			invalid |= digit;
+			value = (value << 4) | (digit & 0x0F);
+		}
+		invalid &= 0x80;
+	} else {
+		for (; ptr < end; ptr++) {
+			const unsigned digit = (unsigned)((unsigned char)(*ptr)) - (unsigned)'0';
+			invalid |= (unsigned)(digit > 9);
+			value = (value * 10) + digit;
+		}
+	}
+	if (invalid != 0) return 0;
+	*out = negative ? -(long long)value : (long long)value;
+	return 1;
+}
+
+
+/**
+ * Parses the given nm output line. The format needs to be BSD with sizes
+ * (nm -S -f bsd) and the numbers in decimal (-t d) or hexadecimal (-t x)
+ * notation. The symbol type needs to be a letter or '?'. The symbol name is
+ * the rest of the line and may contain spaces. Lines which are no symbol
+ * lines but end with a colon are archive member headers.
+ *
+ * @param[in] line - line to parse without line ending
+ * @param[in] len - line length in bytes
+ * @param[in] radix - number radix; 10 for -t d and 16 for -t x
+ * @param[out] out - parsed fields (name points into line)
+ * @return kind of the parsed line
+ */
+tNmLineKind nmline_parse(const char * line, const size_t len, const int radix, tNmLine * out) {
+	uint64_t mask;
+	if (line == NULL || out == NULL) return NMLINE_INVALID;
+	mask = spaceMask(line, len);
+	if (mask != 0 && (mask & (mask - 1)) != 0) {
+		/* value and size field separators */
+		const size_t first = (size_t)__builtin_ctzll(mask);
+		const size_t second = (size_t)__builtin_ctzll(mask & (mask - 1));
+		if ((second + 2) < len && line[second + 2] == ' ') {
+			const char type = line[second + 1];
+			const int validType = ((unsigned)((type | 0x20) - 'a') < 26) || type == '?';
+			if (validType
+				&& parseNumber(line, line + first, radix, &(out->value))
+				&& parseNumber(line + first + 1, line + second, radix, &(out->size))) {
+				out->type = type;
+				out->name = line + second + 3;
+				out->nameLen = len - (second + 3);
+				return NMLINE_SYMBOL;
+			}
+		}
+	}
+	if (len > 1 && line[len - 1] == ':') {
+		out->name = line;
+		out->nameLen = len - 1;
+		return NMLINE_MEMBER;
+	}
+	return NMLINE_INVALID;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file nmline.h
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @see nmline.c
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __LIBPCF_NMLINE_H__
+#define __LIBPCF_NMLINE_H__
+
+#include <stddef.h>
+#include <libpcf/target.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef LIBPCF_DECL
+#define LIBPCF_DECL
+#endif /* LIBPCF_DECL */
+
+#ifndef LIBPCF_DLLPORT
+#define LIBPCF_DLLPORT
+#endif /* LIBPCF_DLLPORT */
+
+
+/**
+ * Defines the possible kinds of nm output lines.
+ */
+typedef enum tNmLineKind {
+	NMLINE_INVALID = 0, /**< not understood (e.g. error message) */
+	NMLINE_SYMBOL  = 1, /**< symbol line */
+	NMLINE_MEMBER  = 2  /**< archive member header (name without the trailing colon) */
+} tNmLineKind;
+
+
+/**
+ * Defines the fields of a parsed nm output line.
+ */
+typedef struct tNmLine {
+	long long value; /**< symbol value */
+	long long size; /**< symbol size (may be negative) */
+	char type; /**< symbol type character (letter or '?') */
+	const char * name; /**< symbol or archive member name within the parsed line (not null-terminated) */
+	size_t nameLen; /**< length of name in bytes */
+} tNmLine;
+
+
+LIBPCF_DLLPORT tNmLineKind LIBPCF_DECL nmline_parse(const char * line, const size_t len, const int radix, tNmLine * out);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* __LIBPCF_NMLINE_H__ */
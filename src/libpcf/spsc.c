@@ -0,0 +1,177 @@
+/**
+ * @file spsc.c
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @see spsc.h
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#include <stdlib.h>
+#include <libpcf/spsc.h>
+#include <libpcf/thread.h>
+
+
+/**
+ * Number of busy wait iterations before the waiting thread yields.
+ */
+#define SPIN_COUNT 64
+
+
+/**
+ * Number of yields before the waiting thread starts to sleep.
+ */
+#define YIELD_COUNT 64
+
+
+/**
+ * Waits a little bit longer with each call.
+ *
+ * @param[in,out] round - current wait round (start with 0)
+ * @internal
+ */
+static void backoff(unsigned int * round) {
+	if (*round < SPIN_COUNT) {
+		/* busy wait */
+	} else if (*round < (SPIN_COUNT + YIELD_COUNT)) {
+		thread_yield();
+	} else {
+		thread_sleep(1);
+		return;
+	}
+	(*round)++;
+}
+
+
+/**
+ * Creates a new queue. The capacity is rounded up to the next power of two.
+ *
+ * @param[in] capacity - maximum number of items in the queue
+ * @return NULL on error or the new queue
+ * @see spsc_free()
+ */
+tSpscQueue * spsc_create(const size_t capacity) {
+	tSpscQueue * q;
+	size_t size = 2;
+	while (size < capacity) {
+		size <<= 1;
+		if (size == 0) return NULL;
+	}
+	q = (tSpscQueue *)malloc(sizeof(tSpscQueue));
+	if (q == NULL) return NULL;
+	q->items = (void **)malloc(sizeof(void *) * size);
+	if (q->items == NULL) {
+		free(q);
+		return NULL;
+	}
+	q->mask = size - 1;
+	q->head = 0;
+	q->tail = 0;
+	q->closed = 0;
+	return q;
+}
+
+
+/**
+ * Adds an item to the queue without blocking. Only the producer thread may
+ * call this function.
+ *
+ * @param[in,out] q - queue
+ * @param[in] item - item to add
+ * @return 1 on success, 0 if the queue is full or closed
+ */
+int spsc_push(tSpscQueue * q, void * item) {
+	const size_t tail = __atomic_load_n(&(q->tail), __ATOMIC_RELAXED);
+	if (__atomic_load_n(&(q->closed), __ATOMIC_ACQUIRE) != 0) return 0;
+	if ((tail - __atomic_load_n(&(q->head), __ATOMIC_ACQUIRE)) > q->mask) return 0;
+	q->items[tail & q->mask] = item;
+	__atomic_store_n(&(q->tail), tail + 1, __ATOMIC_RELEASE);
+	return 1;
+}
+
+
+/**
+ * Removes an item from the queue without blocking. Only the consumer thread
+ * may call this function.
+ *
+ * @param[in,out] q - queue
+ * @param[out] item - set to the removed item
+ * @return 1 on success, 0 if the queue is empty
+ */
+int spsc_pop(tSpscQueue * q, void ** item) {
+	const size_t head = __atomic_load_n(&(q->head), __ATOMIC_RELAXED);
+	if (head == __atomic_load_n(&(q->tail), __ATOMIC_ACQUIRE)) return 0;
+	*item = q->items[head & q->mask];
+	__atomic_store_n(&(q->head), head + 1, __ATOMIC_RELEASE);
+	return 1;
+}
+
+
+/**
+ * Adds an item to the queue and waits for free space if needed.
+ *
+ * @param[in,out] q - queue
+ * @param[in] item - item to add
+ * @return 1 on success, 0 if the queue was closed
+ * @see spsc_push()
+ */
+int spsc_pushWait(tSpscQueue * q, void * item) {
+	unsigned int round = 0;
+	while (spsc_push(q, item) == 0) {
+		if (spsc_isClosed(q) != 0) return 0;
+		backoff(&round);
+	}
+	return 1;
+}
+
+
+/**
+ * Removes an item from the queue and waits for one if needed. Remaining items
+ * are still returned after the queue was closed.
+ *
+ * @param[in,out] q - queue
+ * @param[out] item - set to the removed item
+ * @return 1 on success, 0 if the queue is closed and empty
+ * @see spsc_pop()
+ */
+int spsc_popWait(tSpscQueue * q, void ** item) {
+	unsigned int round = 0;
+	while (spsc_pop(q, item) == 0) {
+		if (spsc_isClosed(q) != 0) return spsc_pop(q, item);
+		backoff(&round);
+	}
+	return 1;
+}
+
+
+/**
+ * Closes the queue. No more items can be added afterwards. This may be called
+ * by either side, e.g. by the consumer to abort the producer.
+ *
+ * @param[in,out] q - queue
+ */
+void spsc_close(tSpscQueue * q) {
+	__atomic_store_n(&(q->closed), 1, __ATOMIC_RELEASE);
+}
+
+
+/**
+ * Checks whether the queue was closed.
+ *
+ * @param[in] q - queue
+ * @return 1 if closed, else 0
+ */
+int spsc_isClosed(const tSpscQueue * q) {
+	return __atomic_load_n(&(q->closed), __ATOMIC_ACQUIRE);
+}
+
+
+/**
+ * Frees the given queue. Remaining items are not freed.
+ *
+ * @param[in,out] q - queue from spsc_create()
+ */
+void spsc_free(tSpscQueue * q) {
+	if (q == NULL) return;
+	if (q->items != NULL) free(q->items);
+	free(q);
+}
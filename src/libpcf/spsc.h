@@ -0,0 +1,58 @@
+/**
+ * @file spsc.h
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @see spsc.c
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __LIBPCF_SPSC_H__
+#define __LIBPCF_SPSC_H__
+
+#include <stddef.h>
+#include <libpcf/target.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef LIBPCF_DECL
+#define LIBPCF_DECL
+#endif /* LIBPCF_DECL */
+
+#ifndef LIBPCF_DLLPORT
+#define LIBPCF_DLLPORT
+#endif /* LIBPCF_DLLPORT */
+
+
+/**
+ * Defines a lock-free ring buffer of pointers for exactly one producer
+ * thread and exactly one consumer thread.
+ */
+typedef struct tSpscQueue {
+	void ** items; /**< ring buffer */
+	size_t mask; /**< capacity - 1 (capacity is a power of two) */
+	volatile size_t head; /**< next item to pop (written by the consumer) */
+	volatile size_t tail; /**< next item to push (written by the producer) */
+	volatile int closed; /**< set to 1 if no more items are pushed */
+} tSpscQueue;
+
+
+LIBPCF_DLLPORT tSpscQueue * LIBPCF_DECL spsc_create(const size_t capacity);
+LIBPCF_DLLPORT int LIBPCF_DECL spsc_push(tSpscQueue * q, void * item);
+LIBPCF_DLLPORT int LIBPCF_DECL spsc_pop(tSpscQueue * q, void ** item);
+LIBPCF_DLLPORT int LIBPCF_DECL spsc_pushWait(tSpscQueue * q, void * item);
+LIBPCF_DLLPORT int LIBPCF_DECL spsc_popWait(tSpscQueue * q, void ** item);
+LIBPCF_DLLPORT void LIBPCF_DECL spsc_close(tSpscQueue * q);
+LIBPCF_DLLPORT int LIBPCF_DECL spsc_isClosed(const tSpscQueue * q);
+LIBPCF_DLLPORT void LIBPCF_DECL spsc_free(tSpscQueue * q);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* __LIBPCF_SPSC_H__ */
@@ -0,0 +1,256 @@
+/**
+ * @file strsearch.c
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @see strsearch.h
+ * @date 2026-10-16
+ * @version 2026-10-16
+ * @remarks The vectorized kernels compare a whole block of candidate positions
+ * against the first and the last needle byte at once. Only positions where
+ * both match are verified byte by byte. Case-insensitive kernels fold ASCII
+ * upper case letters of the text to lower case before comparing. The text may
+ * contain null characters (e.g. consecutive null-terminated strings).
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <libpcf/strsearch.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define HAS_SSE2 1
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#include <immintrin.h>
+#define HAS_AVX2 1
+#endif
+
+
+/**
+ * Checks whether the text at the given position equals the needle.
+ *
+ * @param[in] s - prepared search
+ * @param[in] text - candidate position (needs s->len bytes)
+ * @return 1 if equal, else 0
+ * @internal
+ */
+static inline int equalsAt(const tStrSearch * s, const char * text) {
+	size_t i;
+	if (s->ignoreCase == 0) return memcmp(text, s->needle, s->len) == 0;
+	for (i = 0; i < s->len; i++) {
+		if (PCF_TO_LOWER_ASCII(text[i]) != s->needle[i]) return 0;
+	}
+	return 1;
+}
+
+
+/**
+ * Scalar search kernel. Also used for the remaining bytes of the vectorized
+ * kernels.
+ *
+ * @param[in] s - prepared search
+ * @param[in] text - text to search in
+ * @param[in] len - text length in bytes
+ * @return first occurrence or NULL
+ * @internal
+ */
+static const char * findScalar(const tStrSearch * s, const char * text, const size_t len) {
+	const char first = s->needle[0];
+	const char * last;
+	const char * pos;
+	if (len < s->len) return NULL;
+	last = text + (len - s->len);
+	if (s->ignoreCase == 0) {
+		for (pos = text; pos <= last; pos++) {
+			pos = (const char *)memchr(pos, first, (size_t)(last - pos) + 1);
+			if (pos == NULL) return NULL;
+			if ( equalsAt(s, pos) ) return pos;
+		}
+	} else {
+		for (pos = text; pos <= last; pos++) {
+			if (PCF_TO_LOWER_ASCII(*pos) == first && equalsAt(s, pos)) return pos;
+		}
+	}
+	return NULL;
+}
+
+
+#ifdef HAS_SSE2
+/**
+ * Folds the ASCII upper case letters of the given block to lower case.
+ *
+ * @param[in] block - text block
+ * @return folded block
+ * @internal
+ */
+static inline __m128i foldSse2(const __m128i block) {
+	const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1)));
+	return _mm_or_si128(block, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+
+/**
+ * SSE2 search kernel. Checks 16 candidate positions per step.
+ *
+ * @param[in] s - prepared search
+ * @param[in] text - text to search in
+ * @param[in] len - text length in bytes
+ * @return first occurrence or NULL
+ * @internal
+ */
+static const char * findSse2(const tStrSearch * s, const char * text, const size_t len) {
+	const __m128i first = _mm_set1_epi8(s->needle[0]);
+	const __m128i last = _mm_set1_epi8(s->needle[s->len - 1]);
+	size_t i = 0;
+	if (len < s->len) return NULL;
+	for (; (i + s->len + 15) <= len; i += 16) {
+		__m128i blockFirst = _mm_loadu_si128((const __m128i *)(text + i));
+		__m128i blockLast = _mm_loadu_si128((const __m128i *)(text + i + s->len - 1));
+		unsigned mask;
+		if (s->ignoreCase != 0) {
+			blockFirst = foldSse2(blockFirst);
+			blockLast = foldSse2(blockLast);
+		}
+		mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last)));
+		while (mask != 0) {
+			const char * pos = text + i + (size_t)__builtin_ctz(mask);
+			if ( equalsAt(s, pos) ) return pos;
+			mask &= mask - 1;
+		}
+	}
+	return findScalar(s, text + i, len - i);
+}
+#endif /* HAS_SSE2 */
+
+
+#ifdef HAS_AVX2
+/**
+ * Folds the ASCII upper case letters of the given block to lower case.
+ *
+ * @param[in] block - text block
+ * @return folded block
+ * @internal
+ */
+__attribute__((target("avx2")))
+static inline __m256i foldAvx2(const __m256i block) {
+	const __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(block, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), block));
+	return _mm256_or_si256(block, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+
+/**
+ * AVX2 search kernel. Checks 32 candidate positions per step.
+ *
+ * @param[in] s - prepared search
+ * @param[in] text - text to search in
+ * @param[in] len - text length in bytes
+ * @return first occurrence or NULL
+ * @internal
+ */
+__attribute__((target("avx2")))
+static const char * findAvx2(const tStrSearch * s, const char * text, const size_t len) {
+	const __m256i first = _mm256_set1_epi8(s->needle[0]);
+	const __m256i last = _mm256_set1_epi8(s->needle[s->len - 1]);
+	size_t i = 0;
+	if (len < s->len) return NULL;
+	for (; (i + s->len + 31) <= len; i += 32) {
+		__m256i blockFirst = _mm256_loadu_si256((const __m256i *)(text + i));
+		__m256i blockLast = _mm256_loadu_si256((const __m256i *)(text + i + s->len - 1));
+		unsigned mask;
+		if (s->ignoreCase != 0) {
+			blockFirst = foldAvx2(blockFirst);
+			blockLast = foldAvx2(blockLast);
+		}
+		mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last)));
+		while (mask != 0) {
+			const char * pos = text + i + (size_t)__builtin_ctz(mask);
+			if ( equalsAt(s, pos) ) return pos;
+			mask &= mask - 1;
+		}
+	}
+	return findScalar(s, text + i, len - i);
+}
+#endif /* HAS_AVX2 */
+
+
+/**
+ * Prepares a substring search for the given needle. The fastest kernel
+ * supported by the current processor is selected.
+ *
+ * @param[in] needle - string to search for (may not contain null characters)
+ * @param[in] len - needle length in bytes (at least 1)
+ * @param[in] ignoreCase - 1 to ignore the case of ASCII letters, else 0
+ * @return NULL on error or the prepared search
+ * @see strsearch_free()
+ */
+tStrSearch * strsearch_create(const char * needle, const size_t len, const int ignoreCase) {
+	tStrSearch * s;
+	size_t i;
+	if (needle == NULL || len == 0) return NULL;
+	s = (tStrSearch *)malloc(sizeof(tStrSearch));
+	if (s == NULL) return NULL;
+	s->needle = (char *)malloc(sizeof(char) * (len + 1));
+	if (s->needle == NULL) {
+		free(s);
+		return NULL;
+	}
+	for (i = 0; i < len; i++) {
+		s->needle[i] = (ignoreCase != 0) ? PCF_TO_LOWER_ASCII(needle[i]) : needle[i];
+	}
+	s->needle[len] = 0;
+	s->len = len;
+	s->ignoreCase = (ignoreCase != 0) ? 1 : 0;
+	s->kernel = findScalar;
+#ifdef HAS_SSE2
+	s->kernel = findSse2;
+#endif /* HAS_SSE2 */
+#ifdef HAS_AVX2
+	__builtin_cpu_init();
+	if ( __builtin_cpu_supports("avx2") ) s->kernel = findAvx2;
+#endif /* HAS_AVX2 */
+	return s;
+}
+
+
+/**
+ * Finds the first occurrence of the prepared needle within the given text.
+ *
+ * @param[in] s - prepared search
+ * @param[in] text - text to search in (may contain null characters)
+ * @param[in] len - text length in bytes
+ * @return first occurrence or NULL if not found
+ */
+const char * strsearch_find(const tStrSearch * s, const char * text, const size_t len) {
+	if (s == NULL || text == NULL) return NULL;
+	return s->kernel(s, text, len);
+}
+
+
+/**
+ * Returns the name of the selected search kernel.
+ *
+ * @param[in] s - prepared search
+ * @return kernel name
+ */
+const char * strsearch_kernelName(const tStrSearch * s) {
+	if (s == NULL) return "none";
+#ifdef HAS_AVX2
+	if (s->kernel == findAvx2) return "avx2";
+#endif /* HAS_AVX2 */
+#ifdef HAS_SSE2
+	if (s->kernel == findSse2) return "sse2";
+#endif /* HAS_SSE2 */
+	return "scalar";
+}
+
+
+/**
+ * Frees the given prepared search.
+ *
+ * @param[in,out] s - prepared search
+ */
+void strsearch_free(tStrSearch * s) {
+	if (s == NULL) return;
+	free(s->needle);
+	free(s);
+}
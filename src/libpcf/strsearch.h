@@ -0,0 +1,66 @@
+/**
+ * @file strsearch.h
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @see strsearch.c
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __LIBPCF_STRSEARCH_H__
+#define __LIBPCF_STRSEARCH_H__
+
+#include <stddef.h>
+#include <libpcf/target.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef LIBPCF_DECL
+#define LIBPCF_DECL
+#endif /* LIBPCF_DECL */
+
+#ifndef LIBPCF_DLLPORT
+#define LIBPCF_DLLPORT
+#endif /* LIBPCF_DLLPORT */
+
+
+struct tStrSearch;
+
+
+/**
+ * Search kernel selected at runtime.
+ *
+ * @param[in] s - prepared search
+ * @param[in] text - text to search in
+ * @param[in] len - text length in bytes
+ * @return first occurrence or NULL
+ */
+typedef const char * (* tStrSearchKernel)(const struct tStrSearch * s, const char * text, const size_t len);
+
+
+/**
+ * Defines a prepared substring search.
+ */
+typedef struct tStrSearch {
+	char * needle; /**< null-terminated needle (lower case if ignoreCase is set) */
+	size_t len; /**< needle length in bytes */
+	int ignoreCase; /**< 1 to ignore the case of ASCII letters */
+	tStrSearchKernel kernel; /**< search implementation for the current processor */
+} tStrSearch;
+
+
+LIBPCF_DLLPORT tStrSearch * LIBPCF_DECL strsearch_create(const char * needle, const size_t len, const int ignoreCase);
+LIBPCF_DLLPORT const char * LIBPCF_DECL strsearch_find(const tStrSearch * s, const char * text, const size_t len);
+LIBPCF_DLLPORT const char * LIBPCF_DECL strsearch_kernelName(const tStrSearch * s);
+LIBPCF_DLLPORT void LIBPCF_DECL strsearch_free(tStrSearch * s);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* __LIBPCF_STRSEARCH_H__ */
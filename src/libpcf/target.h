@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2017-2023 Daniel Starke
  * @date 2017-12-02
- * @version 2019-10-07
+ * @version 2026-10-16
  */
 #ifndef __LIBPCF_TARGET_H__
 #define __LIBPCF_TARGET_H__
@@ -450,6 +450,10 @@ static inline uint64_t rotateRight64(uint64_t x, const uint8_t n) {
 #define PCF_MAX(x, y) ((x) >= (y) ? (x) : (y))
 
 
+/* ASCII character to lower case (independent of the locale) */
+#define PCF_TO_LOWER_ASCII(c) (((unsigned)((unsigned char)(c) - 'A') < 26) ? (char)((c) | 0x20) : (c))
+
+
 /* suppress unused parameter warning */
 #ifdef _MSC_VER
 # define PCF_UNUSED(x)
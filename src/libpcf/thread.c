@@ -0,0 +1,326 @@
+/**
+ * @file thread.c
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @see thread.h
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <libpcf/thread.h>
+
+#ifdef PCF_IS_WIN
+#include <process.h>
+#include <windows.h>
+#else /* ! PCF_IS_WIN */
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#endif /* PCF_IS_WIN */
+
+
+/**
+ * Internal thread handle.
+ */
+struct tThread {
+#ifdef PCF_IS_WIN
+	HANDLE handle; /**< native thread handle */
+#else /* ! PCF_IS_WIN */
+	pthread_t handle; /**< native thread handle */
+#endif /* PCF_IS_WIN */
+	tThreadFunc func; /**< user thread function */
+	void * param; /**< user defined parameter */
+};
+
+
+/**
+ * Internal mutex handle.
+ */
+struct tMutex {
+#ifdef PCF_IS_WIN
+	CRITICAL_SECTION handle; /**< native mutex handle */
+#else /* ! PCF_IS_WIN */
+	pthread_mutex_t handle; /**< native mutex handle */
+#endif /* PCF_IS_WIN */
+};
+
+
+/**
+ * Internal condition variable handle.
+ */
+struct tCondition {
+#ifdef PCF_IS_WIN
+	CONDITION_VARIABLE handle; /**< native condition variable handle */
+#else /* ! PCF_IS_WIN */
+	pthread_cond_t handle; /**< native condition variable handle */
+#endif /* PCF_IS_WIN */
+};
+
+
+/**
+ * Native thread entry point which calls the user function.
+ *
+ * @param[in] param - pointer to tThread
+ * @internal
+ */
+#ifdef PCF_IS_WIN
+static unsigned __stdcall threadEntry(void * param) {
+	tThread * thread = (tThread *)param;
+	thread->func(thread->param);
+	return 0;
+}
+#else /* ! PCF_IS_WIN */
+static void * threadEntry(void * param) {
+	tThread * thread = (tThread *)param;
+	thread->func(thread->param);
+	return NULL;
+}
+#endif /* PCF_IS_WIN */
+
+
+/**
+ * Creates and starts a new thread which executes the given function.
+ *
+ * @param[in] func - thread function
+ * @param[in] param - user defined parameter passed to func
+ * @return NULL on error or the handle to the new thread
+ * @see thread_join()
+ */
+tThread * thread_create(tThreadFunc func, void * param) {
+	tThread * thread;
+	if (func == NULL) return NULL;
+	thread = (tThread *)malloc(sizeof(tThread));
+	if (thread == NULL) return NULL;
+	thread->func = func;
+	thread->param = param;
+#ifdef PCF_IS_WIN
+	thread->handle = (HANDLE)_beginthreadex(NULL, 0, threadEntry, thread, 0, NULL);
+	if (thread->handle == NULL) {
+		free(thread);
+		return NULL;
+	}
+#else /* ! PCF_IS_WIN */
+	if (pthread_create(&(thread->handle), NULL, threadEntry, thread) != 0) {
+		free(thread);
+		return NULL;
+	}
+#endif /* PCF_IS_WIN */
+	return thread;
+}
+
+
+/**
+ * Waits until the given thread terminates and frees its handle.
+ *
+ * @param[in,out] thread - handle from thread_create()
+ */
+void thread_join(tThread * thread) {
+	if (thread == NULL) return;
+#ifdef PCF_IS_WIN
+	WaitForSingleObject(thread->handle, INFINITE);
+	CloseHandle(thread->handle);
+#else /* ! PCF_IS_WIN */
+	pthread_join(thread->handle, NULL);
+#endif /* PCF_IS_WIN */
+	free(thread);
+}
+
+
+/**
+ * Returns the number of logical processors available.
+ *
+ * @return number of logical processors (at least 1)
+ */
+size_t thread_cpuCount(void) {
+#ifdef PCF_IS_WIN
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (info.dwNumberOfProcessors > 0) ? (size_t)info.dwNumberOfProcessors : 1;
+#else /* ! PCF_IS_WIN */
+	const long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return (count > 0) ? (size_t)count : 1;
+#endif /* PCF_IS_WIN */
+}
+
+
+/**
+ * Gives up the remaining time slice of the calling thread.
+ */
+void thread_yield(void) {
+#ifdef PCF_IS_WIN
+	SwitchToThread();
+#else /* ! PCF_IS_WIN */
+	sched_yield();
+#endif /* PCF_IS_WIN */
+}
+
+
+/**
+ * Suspends the calling thread for the given time.
+ *
+ * @param[in] ms - time in milliseconds
+ */
+void thread_sleep(const unsigned long ms) {
+#ifdef PCF_IS_WIN
+	Sleep((DWORD)ms);
+#else /* ! PCF_IS_WIN */
+	struct timespec ts;
+	ts.tv_sec = (time_t)(ms / 1000);
+	ts.tv_nsec = (long)((ms % 1000) * 1000000);
+	while (nanosleep(&ts, &ts) != 0 && errno == EINTR);
+#endif /* PCF_IS_WIN */
+}
+
+
+/**
+ * Returns the value of a monotonic clock.
+ *
+ * @return clock value in milliseconds
+ */
+uint64_t thread_ticks(void) {
+#ifdef PCF_IS_WIN
+	return (uint64_t)GetTickCount64();
+#else /* ! PCF_IS_WIN */
+	struct timespec ts;
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) return 0;
+	return ((uint64_t)ts.tv_sec * 1000) + (uint64_t)(ts.tv_nsec / 1000000);
+#endif /* PCF_IS_WIN */
+}
+
+
+/**
+ * Creates a new non-recursive mutex.
+ *
+ * @return NULL on error or the handle to the new mutex
+ * @see thread_mutexFree()
+ */
+tMutex * thread_mutexCreate(void) {
+	tMutex * mutex = (tMutex *)malloc(sizeof(tMutex));
+	if (mutex == NULL) return NULL;
+#ifdef PCF_IS_WIN
+	InitializeCriticalSection(&(mutex->handle));
+#else /* ! PCF_IS_WIN */
+	if (pthread_mutex_init(&(mutex->handle), NULL) != 0) {
+		free(mutex);
+		return NULL;
+	}
+#endif /* PCF_IS_WIN */
+	return mutex;
+}
+
+
+/**
+ * Locks the given mutex. Blocks until the mutex becomes available.
+ *
+ * @param[in,out] mutex - handle from thread_mutexCreate()
+ */
+void thread_mutexLock(tMutex * mutex) {
+	if (mutex == NULL) return;
+#ifdef PCF_IS_WIN
+	EnterCriticalSection(&(mutex->handle));
+#else /* ! PCF_IS_WIN */
+	pthread_mutex_lock(&(mutex->handle));
+#endif /* PCF_IS_WIN */
+}
+
+
+/**
+ * Unlocks the given mutex.
+ *
+ * @param[in,out] mutex - handle from thread_mutexCreate()
+ */
+void thread_mutexUnlock(tMutex * mutex) {
+	if (mutex == NULL) return;
+#ifdef PCF_IS_WIN
+	LeaveCriticalSection(&(mutex->handle));
+#else /* ! PCF_IS_WIN */
+	pthread_mutex_unlock(&(mutex->handle));
+#endif /* PCF_IS_WIN */
+}
+
+
+/**
+ * Frees the given mutex. The mutex shall not be locked.
+ *
+ * @param[in,out] mutex - handle from thread_mutexCreate()
+ */
+void thread_mutexFree(tMutex * mutex) {
+	if (mutex == NULL) return;
+#ifdef PCF_IS_WIN
+	DeleteCriticalSection(&(mutex->handle));
+#else /* ! PCF_IS_WIN */
+	pthread_mutex_destroy(&(mutex->handle));
+#endif /* PCF_IS_WIN */
+	free(mutex);
+}
+
+
+/**
+ * Creates a new condition variable.
+ *
+ * @return NULL on error or the handle to the new condition variable
+ * @see thread_conditionFree()
+ */
+tCondition * thread_conditionCreate(void) {
+	tCondition * condition = (tCondition *)malloc(sizeof(tCondition));
+	if (condition == NULL) return NULL;
+#ifdef PCF_IS_WIN
+	InitializeConditionVariable(&(condition->handle));
+#else /* ! PCF_IS_WIN */
+	if (pthread_cond_init(&(condition->handle), NULL) != 0) {
+		free(condition);
+		return NULL;
+	}
+#endif /* PCF_IS_WIN */
+	return condition;
+}
+
+
+/**
+ * Unlocks the given mutex, blocks until the condition variable gets signaled
+ * and locks the mutex again. Spurious wake ups are possible, hence, the
+ * caller needs to check its condition in a loop.
+ *
+ * @param[in,out] condition - handle from thread_conditionCreate()
+ * @param[in,out] mutex - handle from thread_mutexCreate() locked by the caller
+ */
+void thread_conditionWait(tCondition * condition, tMutex * mutex) {
+	if (condition == NULL || mutex == NULL) return;
+#ifdef PCF_IS_WIN
+	SleepConditionVariableCS(&(condition->handle), &(mutex->handle), INFINITE);
+#else /* ! PCF_IS_WIN */
+	pthread_cond_wait(&(condition->handle), &(mutex->handle));
+#endif /* PCF_IS_WIN */
+}
+
+
+/**
+ * Wakes up all threads waiting for the given condition variable.
+ *
+ * @param[in,out] condition - handle from thread_conditionCreate()
+ */
+void thread_conditionBroadcast(tCondition * condition) {
+	if (condition == NULL) return;
+#ifdef PCF_IS_WIN
+	WakeAllConditionVariable(&(condition->handle));
+#else /* ! PCF_IS_WIN */
+	pthread_cond_broadcast(&(condition->handle));
+#endif /* PCF_IS_WIN */
+}
+
+
+/**
+ * Frees the given condition variable. No thread shall wait for it.
+ *
+ * @param[in,out] condition - handle from thread_conditionCreate()
+ */
+void thread_conditionFree(tCondition * condition) {
+	if (condition == NULL) return;
+#ifndef PCF_IS_WIN
+	pthread_cond_destroy(&(condition->handle));
+#endif /* ! PCF_IS_WIN */
+	free(condition);
+}
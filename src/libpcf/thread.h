@@ -0,0 +1,90 @@
+/**
+ * @file thread.h
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @see thread.c
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __LIBPCF_THREAD_H__
+#define __LIBPCF_THREAD_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <libpcf/target.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef LIBPCF_DECL
+#define LIBPCF_DECL
+#endif /* LIBPCF_DECL */
+
+#ifndef LIBPCF_DLLPORT
+#define LIBPCF_DLLPORT
+#endif /* LIBPCF_DLLPORT */
+
+
+/**
+ * Opaque thread handle.
+ */
+typedef struct tThread tThread;
+
+
+/**
+ * Opaque mutex handle.
+ */
+typedef struct tMutex tMutex;
+
+
+/**
+ * Opaque condition variable handle.
+ */
+typedef struct tCondition tCondition;
+
+
+/**
+ * Thread function type.
+ *
+ * @param[in] param - user defined parameter
+ */
+typedef void (*tThreadFunc)(void * param);
+
+
+LIBPCF_DLLPORT tThread * LIBPCF_DECL thread_create(tThreadFunc func, void * param);
+LIBPCF_DLLPORT void LIBPCF_DECL thread_join(tThread * thread);
+LIBPCF_DLLPORT size_t LIBPCF_DECL thread_cpuCount(void);
+LIBPCF_DLLPORT void LIBPCF_DECL thread_yield(void);
+LIBPCF_DLLPORT void LIBPCF_DECL thread_sleep(const unsigned long ms);
+LIBPCF_DLLPORT uint64_t LIBPCF_DECL thread_ticks(void);
+LIBPCF_DLLPORT tMutex * LIBPCF_DECL thread_mutexCreate(void);
+LIBPCF_DLLPORT void LIBPCF_DECL thread_mutexLock(tMutex * mutex);
+LIBPCF_DLLPORT void LIBPCF_DECL thread_mutexUnlock(tMutex * mutex);
+LIBPCF_DLLPORT void LIBPCF_DECL thread_mutexFree(tMutex * mutex);
+LIBPCF_DLLPORT tCondition * LIBPCF_DECL thread_conditionCreate(void);
+LIBPCF_DLLPORT void LIBPCF_DECL thread_conditionWait(tCondition * condition, tMutex * mutex);
+LIBPCF_DLLPORT void LIBPCF_DECL thread_conditionBroadcast(tCondition * condition);
+LIBPCF_DLLPORT void LIBPCF_DECL thread_conditionFree(tCondition * condition);
+
+
+/**
+ * Atomically adds the given value and returns the previous one.
+ *
+ * @param[in,out] value - pointer to the value to change
+ * @param[in] inc - value to add
+ * @return previous value
+ */
+static inline size_t thread_fetchAdd(volatile size_t * value, const size_t inc) {
+	return __atomic_fetch_add(value, inc, __ATOMIC_SEQ_CST);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* __LIBPCF_THREAD_H__ */
@@ -0,0 +1,221 @@
+/**
+ * @file wildcard.c
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @see wildcard.h
+ * @date 2026-10-16
+ * @version 2026-10-16
+ * @remarks The pattern is split at each '*' into segments. The first and last
+ * segment are checked at the start and end of the text unless the pattern
+ * starts or ends with '*'. The other segments are searched from left to right
+ * via their longest literal run with the vectorized substring search. Taking
+ * the leftmost occurrence of each segment is sufficient for '*' and needs no
+ * backtracking.
+ */
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <libpcf/wildcard.h>
+
+
+/**
+ * Checks whether the given segment matches the text at the given position.
+ * The text needs to hold at least seg->len characters.
+ *
+ * @param[in] wc - compiled pattern
+ * @param[in] seg - segment
+ * @param[in] text - text position
+ * @return 1 on match, else 0
+ * @internal
+ */
+static int matchAt(const tWildcard * wc, const tWildcardSegment * seg, const char * text) {
+	size_t i;
+	for (i = 0; i < seg->len; i++) {
+		const char c = seg->pattern[i];
+		if (c == '?') continue;
+		if (c == '#') {
+			if ( ! isdigit((unsigned char)text[i]) ) return 0;
+		} else if (c != ((wc->ignoreCase != 0) ? PCF_TO_LOWER_ASCII(text[i]) : text[i])) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+
+/**
+ * Finds the first occurrence of the given segment within the text range.
+ *
+ * @param[in] wc - compiled pattern
+ * @param[in] seg - segment
+ * @param[in] pos - start of the text range
+ * @param[in] end - end of the text range
+ * @return start of the occurrence or NULL if not found
+ * @internal
+ */
+static const char * findSegment(const tWildcard * wc, const tWildcardSegment * seg, const char * pos, const char * end) {
+	const char * last;
+	if ((size_t)(end - pos) < seg->len) return NULL;
+	last = end - seg->len;
+	if (seg->literal != NULL) {
+		const char * from = pos + seg->literalOffset;
+		for (;;) {
+			const char * found = strsearch_find(seg->literal, from, (size_t)(end - from));
+			const char * candidate;
+			if (found == NULL) return NULL;
+			candidate = found - seg->literalOffset;
+			if (candidate > last) return NULL;
+			if ( matchAt(wc, seg, candidate) ) return candidate;
+			from = found + 1;
+		}
+	}
+	for (; pos <= last; pos++) {
+		if ( matchAt(wc, seg, pos) ) return pos;
+	}
+	return NULL;
+}
+
+
+/**
+ * Compiles the given wildcard pattern. Valid characters for the pattern are:
+ * @li * matches any character 0 to unlimited times
+ * @li ? matches any character exactly once
+ * @li # matches any digit exactly once
+ * Any other character will be expected to be the same as in text to match.
+ *
+ * @param[in] pattern - wildcard pattern
+ * @param[in] ignoreCase - 1 to ignore the case of ASCII letters, else 0
+ * @return NULL on error or the compiled pattern
+ * @see wildcard_free()
+ */
+tWildcard * wildcard_create(const char * pattern, const int ignoreCase) {
+	tWildcard * wc;
+	size_t len, stars, start, i;
+	if (pattern == NULL) return NULL;
+	len = strlen(pattern);
+	stars = 0;
+	for (i = 0; i < len; i++) {
+		if (pattern[i] == '*') stars++;
+	}
+	wc = (tWildcard *)malloc(sizeof(tWildcard));
+	if (wc == NULL) return NULL;
+	/* pattern copy with null-terminated segments */
+	wc->buffer = (char *)malloc(sizeof(char) * (len + 1));
+	wc->segments = (tWildcardSegment *)malloc(sizeof(tWildcardSegment) * (stars + 1));
+	wc->count = 0;
+	if (wc->buffer == NULL || wc->segments == NULL) {
+		wildcard_free(wc);
+		return NULL;
+	}
+	for (i = 0; i <= len; i++) {
+		wc->buffer[i] = (ignoreCase != 0) ? PCF_TO_LOWER_ASCII(pattern[i]) : pattern[i];
+	}
+	wc->ignoreCase = (ignoreCase != 0) ? 1 : 0;
+	wc->minLen = 0;
+	wc->anchoredStart = (len == 0 || pattern[0] != '*') ? 1 : 0;
+	wc->anchoredEnd = (len == 0 || pattern[len - 1] != '*') ? 1 : 0;
+	start = 0;
+	for (i = 0; i <= len; i++) {
+		tWildcardSegment * seg;
+		size_t run, bestRun, bestOffset, j;
+		if (i < len && pattern[i] != '*') continue;
+		wc->buffer[i] = 0;
+		/* empty segments are only kept for an empty pattern */
+		if (i == start && len > 0) {
+			start = i + 1;
+			continue;
+		}
+		seg = wc->segments + wc->count;
+		seg->pattern = wc->buffer + start;
+		seg->len = i - start;
+		/* find the longest literal run */
+		bestRun = 0;
+		bestOffset = 0;
+		run = 0;
+		for (j = 0; j < seg->len; j++) {
+			if (seg->pattern[j] == '?' || seg->pattern[j] == '#') {
+				run = 0;
+				continue;
+			}
+			run++;
+			if (run > bestRun) {
+				bestRun = run;
+				bestOffset = j + 1 - run;
+			}
+		}
+		seg->literal = NULL;
+		seg->literalOffset = 0;
+		wc->count++;
+		if (bestRun > 0) {
+			seg->literal = strsearch_create(seg->pattern + bestOffset, bestRun, wc->ignoreCase);
+			seg->literalOffset = bestOffset;
+			if (seg->literal == NULL) {
+				wildcard_free(wc);
+				return NULL;
+			}
+		}
+		wc->minLen += seg->len;
+		start = i + 1;
+	}
+	return wc;
+}
+
+
+/**
+ * Checks whether the whole text matches the compiled pattern.
+ *
+ * @param[in] wc - compiled pattern
+ * @param[in] text - text to match
+ * @return 1 on match, else 0
+ */
+int wildcard_match(const tWildcard * wc, const char * text) {
+	const tWildcardSegment * seg;
+	const tWildcardSegment * segEnd;
+	const char * pos;
+	const char * end;
+	size_t len;
+	if (wc == NULL || text == NULL) return 0;
+	len = strlen(text);
+	if (len < wc->minLen) return 0;
+	seg = wc->segments;
+	segEnd = seg + wc->count;
+	if (wc->anchoredStart != 0 && wc->anchoredEnd != 0 && wc->count == 1) {
+		return (len == seg->len) ? matchAt(wc, seg, text) : 0;
+	}
+	pos = text;
+	end = text + len;
+	if (wc->anchoredStart != 0) {
+		if ( ! matchAt(wc, seg, pos) ) return 0;
+		pos += seg->len;
+		seg++;
+	}
+	if (wc->anchoredEnd != 0) {
+		segEnd--;
+		if ((size_t)(end - pos) < segEnd->len) return 0;
+		end -= segEnd->len;
+		if ( ! matchAt(wc, segEnd, end) ) return 0;
+	}
+	for (; seg < segEnd; seg++) {
+		pos = findSegment(wc, seg, pos, end);
+		if (pos == NULL) return 0;
+		pos += seg->len;
+	}
+	return 1;
+}
+
+
+/**
+ * Frees the given compiled pattern.
+ *
+ * @param[in,out] wc - compiled pattern
+ */
+void wildcard_free(tWildcard * wc) {
+	size_t i;
+	if (wc == NULL) return;
+	if (wc->segments != NULL) {
+		for (i = 0; i < wc->count; i++) strsearch_free(wc->segments[i].literal);
+		free(wc->segments);
+	}
+	if (wc->buffer != NULL) free(wc->buffer);
+	free(wc);
+}
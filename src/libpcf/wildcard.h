@@ -0,0 +1,66 @@
+/**
+ * @file wildcard.h
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @see wildcard.c
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __LIBPCF_WILDCARD_H__
+#define __LIBPCF_WILDCARD_H__
+
+#include <stddef.h>
+#include <libpcf/strsearch.h>
+#include <libpcf/target.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef LIBPCF_DECL
+#define LIBPCF_DECL
+#endif /* LIBPCF_DECL */
+
+#ifndef LIBPCF_DLLPORT
+#define LIBPCF_DLLPORT
+#endif /* LIBPCF_DLLPORT */
+
+
+/**
+ * Defines a part of the pattern between two '*'.
+ */
+typedef struct tWildcardSegment {
+	const char * pattern; /**< segment pattern (may contain '?' and '#') */
+	size_t len; /**< segment length in bytes */
+	tStrSearch * literal; /**< search for the longest run without '?' and '#' or NULL */
+	size_t literalOffset; /**< offset of literal within pattern */
+} tWildcardSegment;
+
+
+/**
+ * Defines a compiled wildcard pattern.
+ */
+typedef struct tWildcard {
+	char * buffer; /**< holds the segment patterns (lower case if ignoreCase is set) */
+	tWildcardSegment * segments; /**< segments in pattern order */
+	size_t count; /**< number of segments */
+	size_t minLen; /**< minimal text length for a match */
+	int anchoredStart; /**< 1 if the first segment needs to match at the start of the text */
+	int anchoredEnd; /**< 1 if the last segment needs to match at the end of the text */
+	int ignoreCase; /**< 1 to ignore the case of ASCII letters */
+} tWildcard;
+
+
+LIBPCF_DLLPORT tWildcard * LIBPCF_DECL wildcard_create(const char * pattern, const int ignoreCase);
+LIBPCF_DLLPORT int LIBPCF_DECL wildcard_match(const tWildcard * wc, const char * text);
+LIBPCF_DLLPORT void LIBPCF_DECL wildcard_free(tWildcard * wc);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* __LIBPCF_WILDCARD_H__ */
@@ -3,12 +3,13 @@
  * @author Daniel Starke
  * @copyright Copyright 2017-2023 Daniel Starke
  * @date 2017-04-29
- * @version 2017-12-02
+ * @version 2026-10-16
  */
 #ifndef __PCF_UTILITY_HPP__
 #define __PCF_UTILITY_HPP__
 
 
+#include <cstddef>
 #include <boost/cstdint.hpp>
 
 
@@ -17,4 +18,44 @@ extern "C" {
 }
 
 
+namespace pcf {
+
+
+/**
+ * Returns the 32-bit FNV-1a hash of the given data.
+ *
+ * @param[in] data - data to hash
+ * @param[in] size - data size in bytes
+ * @return hash value
+ */
+inline boost::uint32_t fnv1a32(const char * data, const size_t size) {
+	boost::uint32_t hash = 0x811C9DC5;
+	for (size_t i = 0; i < size; i++) {
+		hash ^= static_cast<unsigned char>(data[i]);
+		hash *= 0x01000193;
+	}
+	return hash;
+}
+
+
+/**
+ * Returns the 64-bit FNV-1a hash of the given data.
+ *
+ * @param[in] data - data to hash
+ * @param[in] size - data size in bytes
+ * @return hash value
+ */
+inline boost::uint64_t fnv1a64(const char * data, const size_t size) {
+	boost::uint64_t hash = 0xCBF29CE484222325ULL;
+	for (size_t i = 0; i < size; i++) {
+		hash ^= static_cast<unsigned char>(data[i]);
+		hash *= 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+
+} /* namespace pcf */
+
+
 #endif /* __PCF_UTILITY_HPP__ */
@@ -0,0 +1,342 @@
+/**
+ * @file Demangler.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <pcf/gui/Demangler.hpp>
+
+
+namespace pcf {
+namespace gui {
+namespace {
+
+
+/** Number of independently locked cache parts. Needs to be a power of two. */
+static const size_t CACHE_SHARDS = 64;
+/** Maximum number of cached names. Further names are demangled without caching. */
+static const size_t CACHE_LIMIT = 0x100000;
+/** Minimum number of symbols per worker thread. */
+static const size_t MIN_JOB_SIZE = 1024;
+/** Number of jobs which can be queued per worker thread. */
+static const size_t QUEUE_SIZE = 4;
+
+
+} /* anonymous namespace */
+
+
+/**
+ * Constructor. Starts the worker threads.
+ *
+ * @param[in] aThreads - number of threads used by demangle(SymbolList &)
+ * including the calling thread; 0 for one per processor
+ */
+Demangler::Demangler(const size_t aThreads):
+	shards(CACHE_SHARDS),
+	cacheEntries(0)
+{
+	for (std::vector<CacheShard>::iterator it = this->shards.begin(); it != this->shards.end(); ++it) {
+		it->mutex = thread_mutexCreate();
+		it->buckets.resize(64, NULL);
+		it->count = 0;
+	}
+	const size_t threads = (aThreads > 0) ? aThreads : thread_cpuCount();
+	/* the worker list may not be reallocated once the threads are running */
+	this->workers.reserve(threads);
+	for (size_t i = 1; i < threads; i++) {
+		Worker worker;
+		worker.owner = this;
+		worker.thread = NULL;
+		worker.jobs = spsc_create(QUEUE_SIZE);
+		worker.done = spsc_create(QUEUE_SIZE);
+		if (worker.jobs == NULL || worker.done == NULL) {
+			if (worker.jobs != NULL) spsc_free(worker.jobs);
+			if (worker.done != NULL) spsc_free(worker.done);
+			break;
+		}
+		this->workers.push_back(worker);
+		Worker & added = this->workers.back();
+		added.thread = thread_create(Demangler::workerMain, &added);
+		if (added.thread == NULL) {
+			spsc_free(added.jobs);
+			spsc_free(added.done);
+			this->workers.pop_back();
+			break;
+		}
+	}
+}
+
+
+/**
+ * Destructor. Stops the worker threads and frees the cache.
+ */
+Demangler::~Demangler() {
+	for (std::vector<Worker>::iterator it = this->workers.begin(); it != this->workers.end(); ++it) {
+		spsc_close(it->jobs);
+	}
+	for (std::vector<Worker>::iterator it = this->workers.begin(); it != this->workers.end(); ++it) {
+		thread_join(it->thread);
+		spsc_free(it->jobs);
+		spsc_free(it->done);
+	}
+	for (std::vector<CacheShard>::iterator it = this->shards.begin(); it != this->shards.end(); ++it) {
+		for (std::vector<CacheEntry *>::iterator bucket = it->buckets.begin(); bucket != it->buckets.end(); ++bucket) {
+			CacheEntry * entry = *bucket;
+			while (entry != NULL) {
+				CacheEntry * next = entry->next;
+				free(entry->mangled);
+				if (entry->demangled != NULL) free(entry->demangled);
+				delete entry;
+				entry = next;
+			}
+		}
+		thread_mutexFree(it->mutex);
+	}
+}
+
+
+/**
+ * Demangles the given symbol name.
+ *
+ * @param[in] name - symbol name
+ * @param[in,out] ctx - thread local context
+ * @return demangled name (valid until the next call with ctx) or NULL if name could not be demangled
+ */
+const char * Demangler::demangle(const char * name, Context & ctx) {
+	const char * symStart = strstr(name, "_Z");
+	if (symStart == NULL) {
+		symStart = name;
+	}
+	const char * attribute = strchr(symStart, '.');
+	if (attribute == NULL) {
+		attribute = symStart + strlen(symStart);
+	}
+	/* demangle without compiler attribute */
+	const size_t len = size_t(attribute - symStart);
+	const uint64_t hash = fnv1a64(symStart, len);
+	const char * realSymName = NULL;
+	if ( ! this->lookup(symStart, len, hash, &realSymName) ) {
+		ctx.key.assign(symStart, attribute);
+		ctx.key.push_back(0);
+		int status;
+		char * result = abi::__cxa_demangle(&(ctx.key[0]), ctx.buffer, &(ctx.bufferSize), &status);
+		if (status == 0 && result != NULL) {
+			/* the output buffer may have been reallocated */
+			ctx.buffer = result;
+			realSymName = result;
+		}
+		this->insert(symStart, len, hash, realSymName);
+	}
+	if (realSymName == NULL) return NULL;
+	/* got demangled name */
+	const size_t prefixLen = size_t(symStart - name);
+	const size_t realSymLen = strlen(realSymName);
+	const size_t attributeLen = strlen(attribute);
+	ctx.result.resize(prefixLen + realSymLen + attributeLen + 1);
+	char * newName = &(ctx.result[0]);
+	memcpy(newName, name, sizeof(char) * prefixLen);
+	memcpy(newName + prefixLen, realSymName, sizeof(char) * realSymLen);
+	memcpy(newName + prefixLen + realSymLen, attribute, sizeof(char) * (attributeLen + 1));
+	return newName;
+}
+
+
+/**
+ * Demangles the names of the given symbol range. The range is split into
+ * slices which are processed by the worker threads and the calling thread.
+ * Names which cannot be demangled are kept as they are. The resulting names
+ * are added to the given pool and their offsets appended in symbol order.
+ *
+ * @param[in] list - symbols to demangle
+ * @param[in] first - index of the first symbol
+ * @param[in] last - index one past the last symbol
+ * @param[in,out] names - add resulting names here
+ * @param[in,out] offsets - append the offsets of the resulting names here
+ * @return true on success, false on allocation error
+ */
+bool Demangler::demangle(const SymbolList & list, const size_t first, const size_t last, StringPool & names, SymbolList::OffsetList & offsets) {
+	if (first >= last) return true;
+	const size_t count = last - first;
+	const size_t slices = std::min(this->workers.size() + 1, (count + MIN_JOB_SIZE - 1) / MIN_JOB_SIZE);
+	if (slices <= 1) return this->demangle(list, first, last, this->context, names, offsets);
+	const size_t sliceSize = (count + slices - 1) / slices;
+	Job * jobs = new Job[slices];
+	size_t queued = 0;
+	size_t next = first;
+	for (size_t i = 0; i < (slices - 1); i++, next += sliceSize) {
+		jobs[i].list = &list;
+		jobs[i].first = next;
+		jobs[i].last = next + sliceSize;
+		jobs[i].ok = false;
+		if (spsc_pushWait(this->workers[i].jobs, jobs + i) == 0) break;
+		queued++;
+	}
+	/* the calling thread processes the remaining symbols */
+	Job & own = jobs[slices - 1];
+	own.ok = this->demangle(list, next, last, this->context, own.names, own.offsets);
+	void * item;
+	for (size_t i = 0; i < queued; i++) spsc_popWait(this->workers[i].done, &item);
+	/* concatenate the slice results in symbol order; equal names of different slices share their storage */
+	bool result = (queued + 1) == slices;
+	offsets.reserve(offsets.size() + count);
+	for (size_t i = 0; result && i < slices; i++) {
+		result = jobs[i].ok;
+		for (SymbolList::OffsetList::const_iterator it = jobs[i].offsets.begin(); result && it != jobs[i].offsets.end(); ++it) {
+			const boost::uint32_t offset = names.intern(jobs[i].names.get(*it));
+			result = offset != StringPool::INVALID;
+			offsets.push_back(offset);
+		}
+	}
+	delete [] jobs;
+	return result;
+}
+
+
+/**
+ * Demangles the names of the given symbols in place. The names are stored
+ * in a new, compacted name pool afterwards.
+ *
+ * @param[in,out] list - symbols to demangle
+ * @return true on success, false on allocation error (list unchanged)
+ */
+bool Demangler::demangle(SymbolList & list) {
+	StringPool names;
+	SymbolList::OffsetList offsets;
+	if ( ! this->demangle(list, 0, list.size(), names, offsets) ) return false;
+	list.swapNames(names, offsets);
+	return true;
+}
+
+
+/**
+ * Worker thread function. Processes jobs until the job queue gets closed.
+ *
+ * @param[in,out] param - pointer to Worker
+ */
+void Demangler::workerMain(void * param) {
+	Worker * self = static_cast<Worker *>(param);
+	Context ctx;
+	void * item;
+	while (spsc_popWait(self->jobs, &item) != 0) {
+		Job * job = static_cast<Job *>(item);
+		job->ok = self->owner->demangle(*(job->list), job->first, job->last, ctx, job->names, job->offsets);
+		spsc_pushWait(self->done, job);
+	}
+}
+
+
+/**
+ * Demangles the names of the given symbol range within the calling thread.
+ *
+ * @param[in] list - symbols to demangle
+ * @param[in] first - index of the first symbol
+ * @param[in] last - index one past the last symbol
+ * @param[in,out] ctx - thread local context
+ * @param[in,out] names - add resulting names here
+ * @param[in,out] offsets - append the offsets of the resulting names here
+ * @return true on success, false on allocation error
+ */
+bool Demangler::demangle(const SymbolList & list, const size_t first, const size_t last, Context & ctx, StringPool & names, SymbolList::OffsetList & offsets) {
+	for (size_t i = first; i < last; i++) {
+		const char * name = list.getName(i);
+		const char * newName = this->demangle(name, ctx);
+		const boost::uint32_t offset = names.intern((newName != NULL) ? newName : name);
+		if (offset == StringPool::INVALID) return false;
+		offsets.push_back(offset);
+	}
+	return true;
+}
+
+
+/**
+ * Looks up the given mangled name in the cache.
+ *
+ * @param[in] mangled - mangled name (not null-terminated)
+ * @param[in] len - mangled name length in bytes
+ * @param[in] hash - hash of the mangled name
+ * @param[out] demangled - cached demangled name or NULL if it cannot be demangled
+ * @return true if found, else false
+ */
+bool Demangler::lookup(const char * mangled, const size_t len, const uint64_t hash, const char ** demangled) {
+	CacheShard & shard = this->shards[size_t(hash) & (CACHE_SHARDS - 1)];
+	bool found = false;
+	thread_mutexLock(shard.mutex);
+	for (const CacheEntry * entry = shard.buckets[size_t(hash >> 32) & (shard.buckets.size() - 1)]; entry != NULL; entry = entry->next) {
+		if (entry->hash == hash && strncmp(entry->mangled, mangled, len) == 0 && entry->mangled[len] == 0) {
+			*demangled = entry->demangled;
+			found = true;
+			break;
+		}
+	}
+	thread_mutexUnlock(shard.mutex);
+	return found;
+}
+
+
+/**
+ * Adds the given demangling result to the cache unless the cache is full or
+ * the name was already added by another thread.
+ *
+ * @param[in] mangled - mangled name (not null-terminated)
+ * @param[in] len - mangled name length in bytes
+ * @param[in] hash - hash of the mangled name
+ * @param[in] demangled - demangled name or NULL if it cannot be demangled
+ */
+void Demangler::insert(const char * mangled, const size_t len, const uint64_t hash, const char * demangled) {
+	if (__atomic_load_n(&(this->cacheEntries), __ATOMIC_RELAXED) >= CACHE_LIMIT) return;
+	CacheEntry * newEntry = new CacheEntry;
+	newEntry->hash = hash;
+	newEntry->mangled = static_cast<char *>(malloc(sizeof(char) * (len + 1)));
+	newEntry->demangled = (demangled != NULL) ? strdup(demangled) : NULL;
+	if (newEntry->mangled == NULL || (demangled != NULL && newEntry->demangled == NULL)) {
+		if (newEntry->mangled != NULL) free(newEntry->mangled);
+		if (newEntry->demangled != NULL) free(newEntry->demangled);
+		delete newEntry;
+		return;
+	}
+	memcpy(newEntry->mangled, mangled, sizeof(char) * len);
+	newEntry->mangled[len] = 0;
+	CacheShard & shard = this->shards[size_t(hash) & (CACHE_SHARDS - 1)];
+	thread_mutexLock(shard.mutex);
+	CacheEntry ** bucket = &(shard.buckets[size_t(hash >> 32) & (shard.buckets.size() - 1)]);
+	for (const CacheEntry * entry = *bucket; entry != NULL; entry = entry->next) {
+		if (entry->hash == hash && strcmp(entry->mangled, newEntry->mangled) == 0) {
+			/* added by another thread in the meantime */
+			thread_mutexUnlock(shard.mutex);
+			free(newEntry->mangled);
+			if (newEntry->demangled != NULL) free(newEntry->demangled);
+			delete newEntry;
+			return;
+		}
+	}
+	newEntry->next = *bucket;
+	*bucket = newEntry;
+	shard.count++;
+	if (shard.count > shard.buckets.size()) {
+		/* rehash with twice the number of buckets */
+		std::vector<CacheEntry *> buckets(shard.buckets.size() * 2, NULL);
+		const size_t mask = buckets.size() - 1;
+		for (std::vector<CacheEntry *>::iterator it = shard.buckets.begin(); it != shard.buckets.end(); ++it) {
+			CacheEntry * entry = *it;
+			while (entry != NULL) {
+				CacheEntry * next = entry->next;
+				CacheEntry ** target = &(buckets[size_t(entry->hash >> 32) & mask]);
+				entry->next = *target;
+				*target = entry;
+				entry = next;
+			}
+		}
+		shard.buckets.swap(buckets);
+	}
+	thread_mutexUnlock(shard.mutex);
+	__atomic_fetch_add(&(this->cacheEntries), 1, __ATOMIC_RELAXED);
+}
+
+
+} /* namespace gui */
+} /* namespace pcf */
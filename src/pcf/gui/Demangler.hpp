@@ -0,0 +1,117 @@
+/**
+ * @file Demangler.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __PCF_GUI_DEMANGLER_HPP__
+#define __PCF_GUI_DEMANGLER_HPP__
+
+#include <cstdlib>
+#include <vector>
+#include <pcf/gui/SymbolList.hpp>
+
+
+extern "C" {
+#include <libpcf/spsc.h>
+#include <libpcf/thread.h>
+}
+
+
+namespace pcf {
+namespace gui {
+
+
+/**
+ * Demangles symbol names with a pool of worker threads. Already demangled
+ * names are kept in a cache shared by all threads to demangle repeated names
+ * only once. Compiler generated name suffixes starting with '.' (e.g.
+ * constprop or lto_priv) and any prefix before the mangled name are preserved
+ * and not part of the cache key.
+ */
+class Demangler {
+public:
+	/**
+	 * Thread local demangling state. Each thread calling demangle() needs its
+	 * own context.
+	 */
+	struct Context {
+		char * buffer; /* reusable __cxa_demangle() output buffer */
+		size_t bufferSize;
+		std::vector<char> key; /* mangled name without prefix and suffix */
+		std::vector<char> result; /* last demangled name */
+
+		explicit Context():
+			buffer(NULL),
+			bufferSize(0)
+		{}
+
+		~Context() {
+			if (this->buffer != NULL) free(this->buffer);
+		}
+	private:
+		Context(const Context &);
+		Context & operator= (const Context &);
+	};
+private:
+	/** Cached demangling result. */
+	struct CacheEntry {
+		CacheEntry * next; /* next entry in the same bucket */
+		uint64_t hash;
+		char * mangled;
+		char * demangled; /* NULL if the name cannot be demangled */
+	};
+
+	/** Independently locked part of the cache. */
+	struct CacheShard {
+		tMutex * mutex;
+		std::vector<CacheEntry *> buckets;
+		size_t count;
+	};
+
+	/** Slice of a symbol list assigned to a worker thread. */
+	struct Job {
+		const SymbolList * list;
+		size_t first;
+		size_t last;
+		StringPool names; /* names of this slice */
+		SymbolList::OffsetList offsets; /* name offsets of this slice */
+		bool ok;
+	};
+
+	struct Worker {
+		Demangler * owner;
+		tThread * thread;
+		tSpscQueue * jobs; /* caller -> worker */
+		tSpscQueue * done; /* worker -> caller */
+	};
+
+	std::vector<CacheShard> shards;
+	volatile size_t cacheEntries;
+	std::vector<Worker> workers;
+	Context context; /* used by the thread calling demangle(SymbolList &) */
+public:
+	explicit Demangler(const size_t aThreads = 0);
+	~Demangler();
+
+	const char * demangle(const char * name, Context & ctx);
+	bool demangle(const SymbolList & list, const size_t first, const size_t last, StringPool & names, SymbolList::OffsetList & offsets);
+	bool demangle(SymbolList & list);
+private:
+	Demangler(const Demangler &);
+	Demangler & operator= (const Demangler &);
+
+	static void workerMain(void * param);
+
+	bool demangle(const SymbolList & list, const size_t first, const size_t last, Context & ctx, StringPool & names, SymbolList::OffsetList & offsets);
+	bool lookup(const char * mangled, const size_t len, const uint64_t hash, const char ** demangled);
+	void insert(const char * mangled, const size_t len, const uint64_t hash, const char * demangled);
+};
+
+
+} /* namespace gui */
+} /* namespace pcf */
+
+
+#endif /* __PCF_GUI_DEMANGLER_HPP__ */
@@ -0,0 +1,241 @@
+/**
+ * @file FileWatcher.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#include <FL/filename.H>
+#include <pcf/gui/FileWatcher.hpp>
+
+
+extern "C" {
+#include <sys/stat.h>
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
+}
+
+
+namespace pcf {
+namespace gui {
+namespace {
+
+
+/** Time without changes until the files are considered stable in seconds. */
+static const double SETTLE_TIME = 0.5;
+/** Interval between two file checks if inotify is not available in seconds. */
+static const double POLL_INTERVAL = 1.0;
+
+
+} /* anonymous namespace */
+
+
+/**
+ * Constructor.
+ *
+ * @param[in] aCallback - called within the GUI thread once the watched files changed
+ * @param[in] aUserData - passed to the callback
+ */
+FileWatcher::FileWatcher(Callback aCallback, void * aUserData):
+	callback(aCallback),
+	userData(aUserData),
+	fd(-1)
+{
+#ifdef __linux__
+	this->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (this->fd >= 0) {
+		Fl::add_fd(this->fd, FL_READ, FileWatcher::onEvents, this);
+		return;
+	}
+#endif
+	Fl::add_timeout(POLL_INTERVAL, FileWatcher::onPoll, this);
+}
+
+
+/**
+ * Destructor.
+ */
+FileWatcher::~FileWatcher() {
+	Fl::remove_timeout(FileWatcher::onSettle, this);
+	Fl::remove_timeout(FileWatcher::onPoll, this);
+#ifdef __linux__
+	if (this->fd >= 0) {
+		Fl::remove_fd(this->fd);
+		close(this->fd);
+	}
+#endif
+}
+
+
+/**
+ * Adds the given file to the watch list. The parent directory is watched to
+ * detect replaced files as well.
+ *
+ * @param[in] path - file path
+ */
+void FileWatcher::add(const char * path) {
+	if (path == NULL || *path == 0) return;
+	for (std::vector<Entry>::const_iterator it = this->entries.begin(); it != this->entries.end(); ++it) {
+		if (strcmp(it->path, path) == 0) return;
+	}
+	char * newPath = strdup(path);
+	if (newPath == NULL) return;
+	this->entries.push_back(Entry(newPath));
+	Entry & entry = this->entries.back();
+	entry.base = entry.last = FileWatcher::getState(path);
+#ifdef __linux__
+	if (this->fd >= 0) {
+		const char * name = fl_filename_name(path);
+		char * dir = (name > path) ? strndup(path, size_t(name - path)) : strdup(".");
+		if (dir != NULL) {
+			entry.wd = inotify_add_watch(this->fd, dir, IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MODIFY | IN_MOVED_FROM | IN_MOVED_TO);
+			free(dir);
+		}
+	}
+#endif
+}
+
+
+/**
+ * Removes all files from the watch list.
+ */
+void FileWatcher::clear() {
+	Fl::remove_timeout(FileWatcher::onSettle, this);
+#ifdef __linux__
+	if (this->fd >= 0) {
+		/* watch descriptors are shared by files in the same directory */
+		for (std::vector<Entry>::const_iterator it = this->entries.begin(); it != this->entries.end(); ++it) {
+			if (it->wd >= 0) inotify_rm_watch(this->fd, it->wd);
+		}
+	}
+#endif
+	this->entries.clear();
+}
+
+
+/**
+ * Called by FLTK if inotify events are pending.
+ *
+ * @param[in] aFd - inotify file descriptor
+ * @param[in,out] data - pointer to FileWatcher
+ */
+void FileWatcher::onEvents(int aFd, void * data) {
+#ifdef __linux__
+	FileWatcher * self = static_cast<FileWatcher *>(data);
+	union {
+		struct inotify_event event;
+		char raw[0x4000];
+	} buffer;
+	bool changed = false;
+	for (;;) {
+		const ssize_t len = read(aFd, buffer.raw, sizeof(buffer.raw));
+		if (len <= 0) break;
+		for (ssize_t pos = 0; pos < len; ) {
+			const struct inotify_event * event = reinterpret_cast<const struct inotify_event *>(buffer.raw + pos);
+			pos += ssize_t(sizeof(struct inotify_event) + event->len);
+			if ((event->mask & IN_Q_OVERFLOW) != 0) {
+				changed = true;
+				continue;
+			}
+			if (event->len <= 0) continue;
+			for (std::vector<Entry>::const_iterator it = self->entries.begin(); it != self->entries.end(); ++it) {
+				if (it->wd == event->wd && strcmp(fl_filename_name(it->path), event->name) == 0) {
+					changed = true;
+					break;
+				}
+			}
+		}
+	}
+	if ( changed ) self->settle();
+#else /* not Linux */
+	(void)aFd;
+	(void)data;
+#endif /* not Linux */
+}
+
+
+/**
+ * Called periodically if the files are polled for changes.
+ *
+ * @param[in,out] data - pointer to FileWatcher
+ */
+void FileWatcher::onPoll(void * data) {
+	FileWatcher * self = static_cast<FileWatcher *>(data);
+	if ( ! Fl::has_timeout(FileWatcher::onSettle, self) ) {
+		for (std::vector<Entry>::const_iterator it = self->entries.begin(); it != self->entries.end(); ++it) {
+			if (FileWatcher::getState(it->path) != it->base) {
+				self->settle();
+				break;
+			}
+		}
+	}
+	Fl::repeat_timeout(POLL_INTERVAL, FileWatcher::onPoll, self);
+}
+
+
+/**
+ * Called once no changes were reported for SETTLE_TIME. The callback is
+ * invoked if all files exist and did not change since the last check.
+ *
+ * @param[in,out] data - pointer to FileWatcher
+ */
+void FileWatcher::onSettle(void * data) {
+	FileWatcher * self = static_cast<FileWatcher *>(data);
+	bool stable = true;
+	bool changed = false;
+	for (std::vector<Entry>::iterator it = self->entries.begin(); it != self->entries.end(); ++it) {
+		const FileState state = FileWatcher::getState(it->path);
+		if (state != it->last) stable = false;
+		if (state != it->base) changed = true;
+		/* missing or empty files are not complete yet */
+		if ( ! (state.exists && state.size > 0) ) stable = false;
+		it->last = state;
+	}
+	if ( ! stable ) {
+		/* still being written; a missing file may also have been removed for good */
+		if ( changed ) Fl::repeat_timeout(SETTLE_TIME, FileWatcher::onSettle, self);
+		return;
+	}
+	if ( ! changed ) return;
+	for (std::vector<Entry>::iterator it = self->entries.begin(); it != self->entries.end(); ++it) {
+		it->base = it->last;
+	}
+	if (self->callback != NULL) self->callback(self->userData);
+}
+
+
+/**
+ * Returns the current state of the given file.
+ *
+ * @param[in] path - file path
+ * @return file state
+ */
+FileWatcher::FileState FileWatcher::getState(const char * path) {
+	struct stat fileInfo[1];
+	if (fl_stat(path, fileInfo) < 0) return FileState();
+#ifdef __linux__
+	const long long int mtime = (static_cast<long long int>(fileInfo->st_mtim.tv_sec) * 1000000000LL) + static_cast<long long int>(fileInfo->st_mtim.tv_nsec);
+#else
+	const long long int mtime = static_cast<long long int>(fileInfo->st_mtime) * 1000000000LL;
+#endif
+	return FileState(true, static_cast<long long int>(fileInfo->st_size), mtime);
+}
+
+
+/**
+ * Restarts the settle timer. Changes are coalesced until the timer expires.
+ */
+void FileWatcher::settle() {
+	Fl::remove_timeout(FileWatcher::onSettle, this);
+	for (std::vector<Entry>::iterator it = this->entries.begin(); it != this->entries.end(); ++it) {
+		it->last = FileWatcher::getState(it->path);
+	}
+	Fl::add_timeout(SETTLE_TIME, FileWatcher::onSettle, this);
+}
+
+
+} /* namespace gui */
+} /* namespace pcf */
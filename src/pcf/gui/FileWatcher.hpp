@@ -0,0 +1,112 @@
+/**
+ * @file FileWatcher.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __PCF_GUI_FILEWATCHER_HPP__
+#define __PCF_GUI_FILEWATCHER_HPP__
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <FL/Fl.H>
+
+
+namespace pcf {
+namespace gui {
+
+
+/**
+ * Watches a set of files for changes within the FLTK event loop. inotify is
+ * used on Linux, the files are polled on other systems. Bursts of changes are
+ * coalesced and the callback is only called once all files are stable again.
+ */
+class FileWatcher {
+public:
+	typedef void (*Callback)(void * userData);
+private:
+	/** Identity of a file used to detect changes. */
+	struct FileState {
+		bool exists;
+		long long int size;
+		long long int mtime; /* in nanoseconds */
+
+		explicit FileState(const bool aExists = false, const long long int aSize = 0, const long long int aMTime = 0):
+			exists(aExists),
+			size(aSize),
+			mtime(aMTime)
+		{}
+
+		bool operator== (const FileState & o) const {
+			return this->exists == o.exists && this->size == o.size && this->mtime == o.mtime;
+		}
+
+		bool operator!= (const FileState & o) const {
+			return !(*this == o);
+		}
+	};
+
+	struct Entry {
+		char * path; /* automatically freed on destruction */
+		int wd; /* inotify watch descriptor or -1 */
+		FileState base; /* state at the last callback */
+		FileState last; /* state at the last check */
+
+		explicit Entry(char * aPath = NULL):
+			path(aPath),
+			wd(-1)
+		{}
+
+		Entry(const Entry & o):
+			path((o.path != NULL) ? strdup(o.path) : NULL),
+			wd(o.wd),
+			base(o.base),
+			last(o.last)
+		{}
+
+		~Entry() {
+			if (this->path != NULL) free(this->path);
+		}
+
+		Entry & operator= (const Entry & o) {
+			if (this != &o) {
+				if (this->path != NULL) free(this->path);
+				this->path = (o.path != NULL) ? strdup(o.path) : NULL;
+				this->wd = o.wd;
+				this->base = o.base;
+				this->last = o.last;
+			}
+			return *this;
+		}
+	};
+
+	std::vector<Entry> entries;
+	Callback callback;
+	void * userData;
+	int fd; /* inotify file descriptor or -1 if polling */
+public:
+	explicit FileWatcher(Callback aCallback, void * aUserData = NULL);
+	~FileWatcher();
+
+	void add(const char * path);
+	void clear();
+private:
+	FileWatcher(const FileWatcher &);
+	FileWatcher & operator= (const FileWatcher &);
+
+	static void onEvents(int aFd, void * data);
+	static void onPoll(void * data);
+	static void onSettle(void * data);
+	static FileState getState(const char * path);
+
+	void settle();
+};
+
+
+} /* namespace gui */
+} /* namespace pcf */
+
+
+#endif /* __PCF_GUI_FILEWATCHER_HPP__ */
@@ -0,0 +1,229 @@
+/**
+ * @file LazyDemangler.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <pcf/gui/LazyDemangler.hpp>
+#include <pcf/gui/Utility.hpp>
+
+
+namespace pcf {
+namespace gui {
+namespace {
+
+
+/** Marks the end of a list. */
+static const size_t NONE = ~size_t(0);
+/** Number of symbols demangled between two cancellation checks. */
+static const size_t CHUNK_SIZE = 0x4000;
+
+
+} /* anonymous namespace */
+
+
+/**
+ * Constructor.
+ *
+ * @param[in] aCapacity - maximum number of cached names
+ * @param[in] aHandler - called within the GUI thread once all names have been demangled
+ * @param[in] aUserData - passed to aHandler
+ */
+LazyDemangler::LazyDemangler(const size_t aCapacity, Fl_Awake_Handler aHandler, void * aUserData):
+	newest(NONE),
+	oldest(NONE),
+	capacity((aCapacity > 0) ? aCapacity : 1),
+	handler(aHandler),
+	userData(aUserData),
+	thread(NULL),
+	cancelled(0),
+	finished(0),
+	list(NULL)
+{
+	size_t bucketCount = 1;
+	while (bucketCount < (2 * this->capacity)) bucketCount <<= 1;
+	this->buckets.resize(bucketCount, NONE);
+	this->entries.reserve(this->capacity);
+}
+
+
+/**
+ * Destructor. Stops demangling in the background.
+ */
+LazyDemangler::~LazyDemangler() {
+	this->cancel();
+	for (std::vector<Entry>::iterator it = this->entries.begin(); it != this->entries.end(); ++it) {
+		free(it->mangled);
+		if (it->demangled != NULL) free(it->demangled);
+	}
+}
+
+
+/**
+ * Returns the demangled name of the given symbol name. The returned string is
+ * only valid until the next call.
+ *
+ * @param[in] name - symbol name
+ * @return demangled name or name if it cannot be demangled
+ */
+const char * LazyDemangler::get(const char * name) {
+	if (name == NULL) return NULL;
+	const uint64_t hash = fnv1a64(name, strlen(name));
+	size_t & bucket = this->buckets[size_t(hash) & (this->buckets.size() - 1)];
+	for (size_t i = bucket; i != NONE; i = this->entries[i].next) {
+		Entry & entry = this->entries[i];
+		if (entry.hash == hash && strcmp(entry.mangled, name) == 0) {
+			if (i != this->newest) {
+				this->unlink(i);
+				this->pushNewest(i);
+			}
+			return (entry.demangled != NULL) ? entry.demangled : name;
+		}
+	}
+	char * mangled = strdup(name);
+	if (mangled == NULL) return name;
+	size_t index;
+	if (this->entries.size() < this->capacity) {
+		index = this->entries.size();
+		this->entries.push_back(Entry());
+	} else {
+		/* replace least recently used entry */
+		index = this->oldest;
+		this->unlink(index);
+		size_t * link = &(this->buckets[size_t(this->entries[index].hash) & (this->buckets.size() - 1)]);
+		while (*link != index) link = &(this->entries[*link].next);
+		*link = this->entries[index].next;
+		free(this->entries[index].mangled);
+		if (this->entries[index].demangled != NULL) free(this->entries[index].demangled);
+	}
+	Entry & entry = this->entries[index];
+	entry.mangled = mangled;
+	const char * demangled = this->demangler.demangle(name, this->context);
+	entry.demangled = (demangled != NULL) ? strdup(demangled) : NULL;
+	entry.hash = hash;
+	entry.next = bucket;
+	bucket = index;
+	this->pushNewest(index);
+	return (entry.demangled != NULL) ? entry.demangled : name;
+}
+
+
+/**
+ * Starts to demangle all names of the given symbol list in the background.
+ * The handler passed to the constructor is called once done. The list may not
+ * be changed until finish() succeeded or cancel() was called.
+ *
+ * @param[in] aList - symbol list
+ * @return true on success, false if already running or on error
+ */
+bool LazyDemangler::demangleAll(const SymbolList & aList) {
+	if (this->thread != NULL) return false;
+	this->resultNames.clear();
+	SymbolList::OffsetList().swap(this->resultOffsets);
+	this->list = &aList;
+	this->cancelled = 0;
+	this->finished = 0;
+	this->thread = thread_create(LazyDemangler::demangleAllMain, this);
+	return this->thread != NULL;
+}
+
+
+/**
+ * Replaces the names of the given symbol list by the names demangled in the
+ * background. This needs to be the list passed to demangleAll(). Previously
+ * returned name pointers become invalid.
+ *
+ * @param[in,out] aList - symbol list
+ * @return true on success, false if not finished yet
+ */
+bool LazyDemangler::finish(SymbolList & aList) {
+	if (this->thread == NULL || __atomic_load_n(&(this->finished), __ATOMIC_ACQUIRE) == 0) return false;
+	thread_join(this->thread);
+	this->thread = NULL;
+	const bool result = this->list == &aList && this->resultOffsets.size() == aList.size();
+	if ( result ) aList.swapNames(this->resultNames, this->resultOffsets);
+	this->resultNames.clear();
+	SymbolList::OffsetList().swap(this->resultOffsets);
+	this->list = NULL;
+	return result;
+}
+
+
+/**
+ * Stops demangling in the background and waits until the thread finished.
+ */
+void LazyDemangler::cancel() {
+	if (this->thread == NULL) return;
+	__atomic_store_n(&(this->cancelled), 1, __ATOMIC_RELEASE);
+	thread_join(this->thread);
+	this->thread = NULL;
+	this->resultNames.clear();
+	SymbolList::OffsetList().swap(this->resultOffsets);
+	this->list = NULL;
+}
+
+
+/**
+ * Background thread function. Demangles all names in chunks with the worker
+ * pool of the demangler.
+ *
+ * @param[in,out] param - pointer to LazyDemangler
+ */
+void LazyDemangler::demangleAllMain(void * param) {
+	LazyDemangler * self = static_cast<LazyDemangler *>(param);
+	const size_t count = self->list->size();
+	self->resultOffsets.reserve(count);
+	for (size_t first = 0; first < count; first += CHUNK_SIZE) {
+		if (__atomic_load_n(&(self->cancelled), __ATOMIC_ACQUIRE) != 0) return;
+		const size_t last = first + std::min(CHUNK_SIZE, count - first);
+		if ( ! self->demangler.demangle(*(self->list), first, last, self->resultNames, self->resultOffsets) ) break;
+	}
+	__atomic_store_n(&(self->finished), 1, __ATOMIC_RELEASE);
+	awake(self->handler, self->userData, &(self->cancelled));
+}
+
+
+/**
+ * Removes the given entry from the LRU list.
+ *
+ * @param[in] index - entry index
+ */
+void LazyDemangler::unlink(const size_t index) {
+	Entry & entry = this->entries[index];
+	if (entry.older != NONE) {
+		this->entries[entry.older].newer = entry.newer;
+	} else {
+		this->oldest = entry.newer;
+	}
+	if (entry.newer != NONE) {
+		this->entries[entry.newer].older = entry.older;
+	} else {
+		this->newest = entry.older;
+	}
+}
+
+
+/**
+ * Adds the given entry as most recently used entry to the LRU list.
+ *
+ * @param[in] index - entry index
+ */
+void LazyDemangler::pushNewest(const size_t index) {
+	Entry & entry = this->entries[index];
+	entry.older = this->newest;
+	entry.newer = NONE;
+	if (this->newest != NONE) {
+		this->entries[this->newest].newer = index;
+	} else {
+		this->oldest = index;
+	}
+	this->newest = index;
+}
+
+
+} /* namespace gui */
+} /* namespace pcf */
@@ -0,0 +1,84 @@
+/**
+ * @file LazyDemangler.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __PCF_GUI_LAZYDEMANGLER_HPP__
+#define __PCF_GUI_LAZYDEMANGLER_HPP__
+
+#include <vector>
+#include <FL/Fl.H>
+#include <pcf/gui/Demangler.hpp>
+#include <pcf/gui/SymbolList.hpp>
+
+
+extern "C" {
+#include <libpcf/thread.h>
+}
+
+
+namespace pcf {
+namespace gui {
+
+
+/**
+ * Demangles symbol names on demand within the GUI thread. The most recently
+ * requested names are kept in a bounded LRU cache. All names of a symbol list
+ * can be demangled in the background at once if needed (e.g. to search within
+ * the demangled names).
+ */
+class LazyDemangler {
+private:
+	/** LRU cache entry. */
+	struct Entry {
+		char * mangled;
+		char * demangled; /* NULL if the name cannot be demangled */
+		uint64_t hash;
+		size_t older; /* LRU list */
+		size_t newer;
+		size_t next; /* next entry in the same bucket */
+	};
+
+	Demangler demangler;
+	Demangler::Context context; /* GUI thread context */
+	std::vector<Entry> entries;
+	std::vector<size_t> buckets;
+	size_t newest;
+	size_t oldest;
+	size_t capacity;
+	/* background demangling of all names */
+	Fl_Awake_Handler handler;
+	void * userData;
+	tThread * thread;
+	volatile int cancelled;
+	volatile int finished;
+	const SymbolList * list; /* symbols to demangle */
+	StringPool resultNames; /* demangled names */
+	SymbolList::OffsetList resultOffsets; /* demangled name offsets in symbol order */
+public:
+	explicit LazyDemangler(const size_t aCapacity, Fl_Awake_Handler aHandler, void * aUserData);
+	~LazyDemangler();
+
+	const char * get(const char * name);
+	bool demangleAll(const SymbolList & aList);
+	bool isDemanglingAll() const { return this->thread != NULL; }
+	bool finish(SymbolList & aList);
+	void cancel();
+private:
+	LazyDemangler(const LazyDemangler &);
+	LazyDemangler & operator= (const LazyDemangler &);
+
+	static void demangleAllMain(void * param);
+
+	void unlink(const size_t index);
+	void pushNewest(const size_t index);
+};
+
+
+} /* namespace gui */
+} /* namespace pcf */
+
+
+#endif /* __PCF_GUI_LAZYDEMANGLER_HPP__ */
@@ -0,0 +1,159 @@
+/**
+ * @file StringPool.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#include <algorithm>
+#include <pcf/gui/StringPool.hpp>
+
+
+namespace pcf {
+namespace gui {
+namespace {
+
+
+/** Initial number of hash table slots. Needs to be a power of two. */
+static const size_t INITIAL_SLOTS = 1024;
+/** Number of bytes searched by find() between two cancellation checks. */
+static const size_t FIND_BLOCK_SIZE = 0x100000;
+
+
+} /* anonymous namespace */
+
+
+const boost::uint32_t StringPool::INVALID;
+
+
+/**
+ * Constructor.
+ */
+StringPool::StringPool():
+	used(0)
+{}
+
+
+/**
+ * Adds the given string to the pool. An equal string already added before is
+ * returned instead of a new copy.
+ *
+ * @param[in] str - string to add (does not need to be null-terminated)
+ * @param[in] len - string length in bytes
+ * @return offset of the null-terminated string within the pool or INVALID on error
+ */
+boost::uint32_t StringPool::intern(const char * str, const size_t len) {
+	if (str == NULL) return INVALID;
+	if ((this->text.size() + len + 1) >= size_t(INVALID)) return INVALID;
+	if ( this->table.empty() ) this->rehash(INITIAL_SLOTS);
+	const boost::uint32_t hash = fnv1a32(str, len);
+	const size_t mask = this->table.size() - 1;
+	size_t i = size_t(hash) & mask;
+	for (; this->table[i].offset != INVALID; i = (i + 1) & mask) {
+		const Slot & slot = this->table[i];
+		if (slot.hash != hash) continue;
+		const char * candidate = this->get(slot.offset);
+		if (memcmp(candidate, str, len) == 0 && candidate[len] == 0) return slot.offset;
+	}
+	const boost::uint32_t offset = boost::uint32_t(this->text.size());
+	this->text.insert(this->text.end(), str, str + len);
+	this->text.push_back(0);
+	this->table[i].offset = offset;
+	this->table[i].hash = hash;
+	this->used++;
+	if ((this->used * 2) > this->table.size()) this->rehash(this->table.size() * 2);
+	return offset;
+}
+
+
+/**
+ * Replaces the content of this pool with a copy of the given one.
+ *
+ * @param[in] other - pool to copy
+ */
+void StringPool::assign(const StringPool & other) {
+	this->text = other.text;
+	this->table = other.table;
+	this->used = other.used;
+}
+
+
+/**
+ * Searches all strings of this pool at once for the given substring. Matches
+ * never span two strings as the needle contains no null character.
+ *
+ * @param[in] search - prepared substring search
+ * @param[out] offsets - receives the offsets of all matching strings in ascending order
+ * @param[in] cancelled - stops searching once this is set to non-zero (optional)
+ * @return true on success, false if cancelled
+ */
+bool StringPool::find(const tStrSearch * search, std::vector<boost::uint32_t> & offsets, const volatile int * cancelled) const {
+	if (search == NULL || this->text.empty()) return true;
+	const char * begin = &(this->text[0]);
+	const char * end = begin + this->text.size();
+	const char * pos = begin; /* always the start of a string */
+	while (pos < end) {
+		if (cancelled != NULL && __atomic_load_n(cancelled, __ATOMIC_ACQUIRE) != 0) return false;
+		/* search block-wise up to the end of a string to check for cancellation in between */
+		const char * blockEnd = pos + std::min(FIND_BLOCK_SIZE, size_t(end - pos)) - 1;
+		blockEnd = static_cast<const char *>(memchr(blockEnd, 0, size_t(end - blockEnd))) + 1;
+		while (pos < blockEnd) {
+			const char * found = strsearch_find(search, pos, size_t(blockEnd - pos));
+			if (found == NULL) break;
+			const char * start = found;
+			while (start > pos && start[-1] != 0) start--;
+			offsets.push_back(boost::uint32_t(start - begin));
+			/* continue with the next string */
+			pos = found + strlen(found) + 1;
+		}
+		pos = blockEnd;
+	}
+	return true;
+}
+
+
+/**
+ * Swaps the content of this pool with the given one.
+ *
+ * @param[in,out] other - swap with this pool
+ */
+void StringPool::swap(StringPool & other) {
+	this->text.swap(other.text);
+	this->table.swap(other.table);
+	std::swap(this->used, other.used);
+}
+
+
+/**
+ * Frees all strings.
+ */
+void StringPool::clear() {
+	std::vector<char>().swap(this->text);
+	std::vector<Slot>().swap(this->table);
+	this->used = 0;
+}
+
+
+/**
+ * Resizes the hash table to the given number of slots.
+ *
+ * @param[in] slots - new number of slots (power of two)
+ */
+void StringPool::rehash(const size_t slots) {
+	Slot unused;
+	unused.offset = INVALID;
+	unused.hash = 0;
+	std::vector<Slot> newTable(slots, unused);
+	const size_t mask = slots - 1;
+	for (std::vector<Slot>::const_iterator it = this->table.begin(); it != this->table.end(); ++it) {
+		if (it->offset == INVALID) continue;
+		size_t i = size_t(it->hash) & mask;
+		while (newTable[i].offset != INVALID) i = (i + 1) & mask;
+		newTable[i] = *it;
+	}
+	this->table.swap(newTable);
+}
+
+
+} /* namespace gui */
+} /* namespace pcf */
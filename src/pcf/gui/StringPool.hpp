@@ -0,0 +1,70 @@
+/**
+ * @file StringPool.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __PCF_GUI_STRINGPOOL_HPP__
+#define __PCF_GUI_STRINGPOOL_HPP__
+
+#include <cstring>
+#include <vector>
+#include <pcf/Utility.hpp>
+
+
+extern "C" {
+#include <libpcf/strsearch.h>
+}
+
+
+namespace pcf {
+namespace gui {
+
+
+/**
+ * Contiguous storage for null-terminated strings which are referenced by
+ * their offset. Equal strings added to the same pool share their storage.
+ * All strings are released at once.
+ */
+class StringPool {
+public:
+	/** Returned on error, e.g. if the pool exceeds the offset range. */
+	static const boost::uint32_t INVALID = 0xFFFFFFFF;
+private:
+	/** Hash table slot of an interned string. */
+	struct Slot {
+		boost::uint32_t offset; /* INVALID if unused */
+		boost::uint32_t hash;
+	};
+
+	std::vector<char> text;
+	std::vector<Slot> table;
+	size_t used; /* number of used slots */
+public:
+	explicit StringPool();
+
+	boost::uint32_t intern(const char * str, const size_t len);
+	boost::uint32_t intern(const char * str) { return this->intern(str, strlen(str)); }
+	void assign(const StringPool & other);
+	bool find(const tStrSearch * search, std::vector<boost::uint32_t> & offsets, const volatile int * cancelled = NULL) const;
+	void swap(StringPool & other);
+	void clear();
+
+	/** @return string at the given offset */
+	const char * get(const boost::uint32_t offset) const { return &(this->text[size_t(offset)]); }
+	/** @return number of bytes in use */
+	size_t bytes() const { return this->text.size(); }
+private:
+	StringPool(const StringPool &);
+	StringPool & operator= (const StringPool &);
+
+	void rehash(const size_t slots);
+};
+
+
+} /* namespace gui */
+} /* namespace pcf */
+
+
+#endif /* __PCF_GUI_STRINGPOOL_HPP__ */
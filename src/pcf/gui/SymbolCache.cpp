@@ -0,0 +1,490 @@
+/**
+ * @file SymbolCache.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ * @remarks The cache file starts with a header followed by the data chunks:
+ * @li header: magic (4 bytes), version (uint32), key length (uint32), key
+ * @li chunk: member count (uint32), symbol count (uint32), text size (uint64),
+ *     symbol records (24 bytes each), text (null-terminated member names
+ *     followed by the null-terminated symbol names)
+ * @li symbol record: size (int64), address (uint64), member index (int32),
+ *     type (char), 3 padding bytes
+ * @li an empty chunk marks the end of the file
+ * All values are stored in host byte order.
+ */
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <FL/filename.H>
+#include <FL/fl_utf8.h>
+#include <pcf/gui/SymbolCache.hpp>
+
+
+extern "C" {
+#include <sys/stat.h>
+#include <libpcf/elfsym.h>
+#ifdef PCF_IS_WIN
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+}
+
+
+namespace pcf {
+namespace gui {
+namespace {
+
+
+/** Cache file signature. */
+static const char CACHE_MAGIC[4] = {'B', 'S', 'S', 'C'};
+/** Cache file format version. Increase on any format change. */
+static const uint32_t CACHE_VERSION = 2;
+/** Cache file header size without the key in bytes. */
+static const size_t HEADER_SIZE = 12;
+/** Chunk header size in bytes. */
+static const size_t CHUNK_SIZE = 16;
+/** Symbol record size in bytes. */
+static const size_t RECORD_SIZE = 24;
+/** Offset of the symbol size within a symbol record. */
+static const size_t RECORD_SIZE_POS = 0;
+/** Offset of the symbol address within a symbol record. */
+static const size_t RECORD_ADDRESS_POS = 8;
+/** Offset of the member index within a symbol record. */
+static const size_t RECORD_MEMBER_POS = 16;
+/** Offset of the symbol type within a symbol record. */
+static const size_t RECORD_TYPE_POS = 20;
+#ifdef PCF_IS_WIN
+/** Path separator. */
+static const char PATH_SEP = '\\';
+#else
+/** Path separator. */
+static const char PATH_SEP = '/';
+#endif
+
+
+/**
+ * Appends the given string to the buffer.
+ *
+ * @param[in,out] buffer - append to this buffer
+ * @param[in] str - string to append
+ */
+void append(std::vector<char> & buffer, const char * str) {
+	if (str != NULL) buffer.insert(buffer.end(), str, str + strlen(str));
+}
+
+
+/**
+ * Appends the identity of the given file to the buffer. This is the file size
+ * and the ELF build ID if requested and available or the modification time.
+ *
+ * @param[in,out] buffer - append to this buffer
+ * @param[in] path - file path
+ * @param[in] useBuildId - try to use the ELF build ID?
+ * @return true on success, false if the file does not exist
+ */
+bool appendIdentity(std::vector<char> & buffer, const char * path, const bool useBuildId) {
+	struct stat fileInfo[1];
+	char str[64];
+	if (fl_stat(path, fileInfo) < 0) return false;
+	snprintf(str, sizeof(str), "size=%lld ", static_cast<long long>(fileInfo->st_size));
+	append(buffer, str);
+	if ( useBuildId ) {
+		tMFile * file = mfile_open(path);
+		if (file != NULL) {
+			const unsigned char * id;
+			size_t len;
+			const bool hasId = elfsym_buildId(file->ptr, file->size, &id, &len) != 0;
+			if ( hasId ) {
+				append(buffer, "build-id=");
+				for (size_t i = 0; i < len; i++) {
+					snprintf(str, sizeof(str), "%02x", unsigned(id[i]));
+					append(buffer, str);
+				}
+			}
+			mfile_close(file);
+			if ( hasId ) return true;
+		}
+	}
+#if defined(__linux__)
+	snprintf(str, sizeof(str), "mtime=%lld.%09ld", static_cast<long long>(fileInfo->st_mtim.tv_sec), static_cast<long>(fileInfo->st_mtim.tv_nsec));
+#else
+	snprintf(str, sizeof(str), "mtime=%lld", static_cast<long long>(fileInfo->st_mtime));
+#endif
+	append(buffer, str);
+	return true;
+}
+
+
+/**
+ * Returns the uint32_t value at the given position.
+ */
+inline uint32_t rd32(const unsigned char * ptr) {
+	uint32_t res;
+	memcpy(&res, ptr, sizeof(res));
+	return res;
+}
+
+
+/**
+ * Returns the uint64_t value at the given position.
+ */
+inline uint64_t rd64(const unsigned char * ptr) {
+	uint64_t res;
+	memcpy(&res, ptr, sizeof(res));
+	return res;
+}
+
+
+} /* anonymous namespace */
+
+
+/**
+ * Constructor. The cache is not valid if the binary does not exist.
+ *
+ * @param[in] aDirectory - cache directory
+ * @param[in] aNmPath - path to nm
+ * @param[in] aBinPath - path to the binary
+ * @param[in] aOptions - load options which influence the cached data (e.g. nm flags)
+ */
+SymbolCache::SymbolCache(const char * aDirectory, const char * aNmPath, const char * aBinPath, const char * aOptions):
+	path(NULL),
+	tmpPath(NULL),
+	key(NULL),
+	keyLen(0),
+	input(NULL),
+	inputPos(0),
+	output(NULL)
+{
+	if (aDirectory == NULL || aNmPath == NULL || aBinPath == NULL) return;
+	/* the cache file location only depends on the paths and options */
+	std::vector<char> buffer;
+	append(buffer, "nm=");
+	append(buffer, aNmPath);
+	append(buffer, "\noptions=");
+	append(buffer, aOptions);
+	append(buffer, "\nbin=");
+	append(buffer, aBinPath);
+	append(buffer, "\n");
+	char name[32];
+	snprintf(name, sizeof(name), "%016llx.sym", static_cast<unsigned long long>(fnv1a64(&(buffer[0]), buffer.size())));
+	/* the cached data depends additionally on the file identities */
+	append(buffer, "nm.id=");
+	if ( ! appendIdentity(buffer, aNmPath, false) ) append(buffer, "none");
+	append(buffer, "\nbin.id=");
+	if ( ! appendIdentity(buffer, aBinPath, true) ) return;
+	append(buffer, "\n");
+	/* store results */
+	const size_t dirLen = strlen(aDirectory);
+	const size_t nameLen = strlen(name);
+	this->path = static_cast<char *>(malloc(sizeof(char) * (dirLen + nameLen + 2)));
+	this->key = static_cast<char *>(malloc(sizeof(char) * buffer.size()));
+	if (this->path == NULL || this->key == NULL) {
+		if (this->path != NULL) free(this->path);
+		if (this->key != NULL) free(this->key);
+		this->path = NULL;
+		this->key = NULL;
+		return;
+	}
+	memcpy(this->path, aDirectory, sizeof(char) * dirLen);
+	this->path[dirLen] = PATH_SEP;
+	memcpy(this->path + dirLen + 1, name, sizeof(char) * (nameLen + 1));
+	memcpy(this->key, &(buffer[0]), sizeof(char) * buffer.size());
+	this->keyLen = buffer.size();
+}
+
+
+/**
+ * Destructor. Incomplete cache files are removed.
+ */
+SymbolCache::~SymbolCache() {
+	this->closeRead();
+	this->abort();
+	if (this->path != NULL) free(this->path);
+	if (this->tmpPath != NULL) free(this->tmpPath);
+	if (this->key != NULL) free(this->key);
+}
+
+
+/**
+ * Returns the default cache directory of the current user.
+ *
+ * @return newly allocated path or NULL if unknown
+ */
+char * SymbolCache::getDefaultDirectory() {
+#ifdef PCF_IS_WIN
+	const char * base = fl_getenv("LOCALAPPDATA");
+	const char * suffix = "\\binstats\\cache";
+#else
+	const char * base = fl_getenv("XDG_CACHE_HOME");
+	const char * suffix = "/binstats";
+	if (base == NULL || *base == 0) {
+		base = fl_getenv("HOME");
+		suffix = "/.cache/binstats";
+	}
+#endif
+	if (base == NULL || *base == 0) return NULL;
+	const size_t baseLen = strlen(base);
+	const size_t suffixLen = strlen(suffix);
+	char * result = static_cast<char *>(malloc(sizeof(char) * (baseLen + suffixLen + 1)));
+	if (result == NULL) return NULL;
+	memcpy(result, base, sizeof(char) * baseLen);
+	memcpy(result + baseLen, suffix, sizeof(char) * (suffixLen + 1));
+	return result;
+}
+
+
+/**
+ * Opens the cache file for reading. The cache file is only accepted if its key
+ * matches and its content is complete.
+ *
+ * @return true on success, false if no matching cache file exists
+ */
+bool SymbolCache::openRead() {
+	if (( ! this->isValid() ) || this->input != NULL) return false;
+	this->input = mfile_open(this->path);
+	if (this->input == NULL) return false;
+	if ( ! this->validate() ) {
+		this->closeRead();
+		return false;
+	}
+	this->inputPos = HEADER_SIZE + this->keyLen;
+	return true;
+}
+
+
+/**
+ * Reads the next chunk from the cache file.
+ *
+ * @param[out] symbols - append symbols to this list
+ * @param[out] members - append new archive members to this list
+ * @return true on success, false at the end of the cache file
+ */
+bool SymbolCache::read(SymbolList & symbols, SymbolViewer::MemberList & members) {
+	if (this->input == NULL) return false;
+	const unsigned char * ptr = static_cast<const unsigned char *>(this->input->ptr) + this->inputPos;
+	const uint32_t memberCount = rd32(ptr);
+	const uint32_t symbolCount = rd32(ptr + 4);
+	const uint64_t textSize = rd64(ptr + 8);
+	if (memberCount == 0 && symbolCount == 0 && textSize == 0) {
+		/* end of file */
+		this->closeRead();
+		return false;
+	}
+	const unsigned char * record = ptr + CHUNK_SIZE;
+	const char * text = reinterpret_cast<const char *>(record + (size_t(symbolCount) * RECORD_SIZE));
+	members.reserve(members.size() + memberCount);
+	for (uint32_t i = 0; i < memberCount; i++) {
+		const size_t len = strlen(text);
+		members.push_back(strdup(text));
+		text += len + 1;
+	}
+	symbols.reserve(symbols.size() + symbolCount);
+	for (uint32_t i = 0; i < symbolCount; i++, record += RECORD_SIZE) {
+		long long int size;
+		uint64_t address;
+		int32_t member;
+		memcpy(&size, record + RECORD_SIZE_POS, sizeof(size));
+		memcpy(&address, record + RECORD_ADDRESS_POS, sizeof(address));
+		memcpy(&member, record + RECORD_MEMBER_POS, sizeof(member));
+		const size_t len = strlen(text);
+		symbols.push_back(static_cast<char>(record[RECORD_TYPE_POS]), size, address, text, len, int(member));
+		text += len + 1;
+	}
+	this->inputPos += CHUNK_SIZE + (size_t(symbolCount) * RECORD_SIZE) + size_t(textSize);
+	return true;
+}
+
+
+/**
+ * Creates a new temporary cache file for writing. It replaces the cache file
+ * on commit().
+ *
+ * @return true on success, else false
+ */
+bool SymbolCache::openWrite() {
+	if (( ! this->isValid() ) || this->output != NULL) return false;
+	/* create cache directory */
+	const size_t pathLen = strlen(this->path);
+	char * directory = strdup(this->path);
+	if (directory == NULL) return false;
+	char * sep = strrchr(directory, PATH_SEP);
+	if (sep != NULL) {
+		*sep = 0;
+		fl_make_path(directory);
+	}
+	free(directory);
+	/* open temporary file */
+	if (this->tmpPath == NULL) {
+		this->tmpPath = static_cast<char *>(malloc(sizeof(char) * (pathLen + 32)));
+		if (this->tmpPath == NULL) return false;
+#ifdef PCF_IS_WIN
+		snprintf(this->tmpPath, pathLen + 32, "%s.%lu.tmp", this->path, static_cast<unsigned long>(_getpid()));
+#else
+		snprintf(this->tmpPath, pathLen + 32, "%s.%lu.tmp", this->path, static_cast<unsigned long>(getpid()));
+#endif
+	}
+	this->output = fl_fopen(this->tmpPath, "wb");
+	if (this->output == NULL) return false;
+	/* write header */
+	const uint32_t version = CACHE_VERSION;
+	const uint32_t keySize = uint32_t(this->keyLen);
+	bool ok = fwrite(CACHE_MAGIC, sizeof(CACHE_MAGIC), 1, this->output) == 1;
+	ok = ok && fwrite(&version, sizeof(version), 1, this->output) == 1;
+	ok = ok && fwrite(&keySize, sizeof(keySize), 1, this->output) == 1;
+	ok = ok && fwrite(this->key, this->keyLen, 1, this->output) == 1;
+	if ( ! ok ) this->abort();
+	return ok;
+}
+
+
+/**
+ * Appends the given symbols and archive members as new chunk to the cache file.
+ *
+ * @param[in] symbols - symbols to write
+ * @param[in] members - new archive members to write
+ * @return true on success, else false
+ */
+bool SymbolCache::write(const SymbolList & symbols, const SymbolViewer::MemberList & members) {
+	if (this->output == NULL) return false;
+	if (symbols.empty() && members.empty()) return true; /* empty chunks mark the end */
+	uint64_t textSize = 0;
+	for (SymbolViewer::MemberList::const_iterator it = members.begin(); it != members.end(); ++it) {
+		textSize += strlen(*it) + 1;
+	}
+	const size_t symbolTotal = symbols.size();
+	for (size_t i = 0; i < symbolTotal; i++) {
+		textSize += strlen(symbols.getName(i)) + 1;
+	}
+	/* chunk header */
+	unsigned char header[CHUNK_SIZE];
+	const uint32_t memberCount = uint32_t(members.size());
+	const uint32_t symbolCount = uint32_t(symbols.size());
+	memcpy(header, &memberCount, sizeof(memberCount));
+	memcpy(header + 4, &symbolCount, sizeof(symbolCount));
+	memcpy(header + 8, &textSize, sizeof(textSize));
+	bool ok = fwrite(header, sizeof(header), 1, this->output) == 1;
+	/* symbol records */
+	const std::vector<char> & types = symbols.getTypes();
+	const std::vector<long long int> & sizes = symbols.getSizes();
+	const std::vector<uint64_t> & addresses = symbols.getAddresses();
+	const std::vector<int> & symbolMembers = symbols.getMembers();
+	for (size_t i = 0; ok && i < symbolTotal; i++) {
+		unsigned char record[RECORD_SIZE] = {0};
+		const long long int size = sizes[i];
+		const uint64_t address = addresses[i];
+		const int32_t member = int32_t(symbolMembers[i]);
+		memcpy(record + RECORD_SIZE_POS, &size, sizeof(size));
+		memcpy(record + RECORD_ADDRESS_POS, &address, sizeof(address));
+		memcpy(record + RECORD_MEMBER_POS, &member, sizeof(member));
+		record[RECORD_TYPE_POS] = static_cast<unsigned char>(types[i]);
+		ok = fwrite(record, sizeof(record), 1, this->output) == 1;
+	}
+	/* text */
+	for (SymbolViewer::MemberList::const_iterator it = members.begin(); ok && it != members.end(); ++it) {
+		ok = fwrite(*it, strlen(*it) + 1, 1, this->output) == 1;
+	}
+	for (size_t i = 0; ok && i < symbolTotal; i++) {
+		const char * name = symbols.getName(i);
+		ok = fwrite(name, strlen(name) + 1, 1, this->output) == 1;
+	}
+	if ( ! ok ) this->abort();
+	return ok;
+}
+
+
+/**
+ * Completes the cache file and replaces the previous one.
+ *
+ * @return true on success, else false
+ */
+bool SymbolCache::commit() {
+	if (this->output == NULL) return false;
+	const unsigned char endMarker[CHUNK_SIZE] = {0};
+	bool ok = fwrite(endMarker, sizeof(endMarker), 1, this->output) == 1;
+	ok = (fclose(this->output) == 0) && ok;
+	this->output = NULL;
+	if ( ok ) {
+		fl_unlink(this->path);
+		ok = fl_rename(this->tmpPath, this->path) == 0;
+	}
+	if ( ! ok ) fl_unlink(this->tmpPath);
+	return ok;
+}
+
+
+/**
+ * Discards the cache file being written.
+ */
+void SymbolCache::abort() {
+	if (this->output == NULL) return;
+	fclose(this->output);
+	this->output = NULL;
+	fl_unlink(this->tmpPath);
+}
+
+
+/**
+ * Closes the cache file opened for reading.
+ */
+void SymbolCache::closeRead() {
+	if (this->input == NULL) return;
+	mfile_close(this->input);
+	this->input = NULL;
+	this->inputPos = 0;
+}
+
+
+/**
+ * Checks the header and the structure of the opened cache file.
+ *
+ * @return true if valid, else false
+ */
+bool SymbolCache::validate() const {
+	const unsigned char * data = static_cast<const unsigned char *>(this->input->ptr);
+	const size_t size = this->input->size;
+	/* header */
+	if (size < (HEADER_SIZE + this->keyLen)) return false;
+	if (memcmp(data, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0) return false;
+	if (rd32(data + 4) != CACHE_VERSION) return false;
+	if (rd32(data + 8) != this->keyLen) return false;
+	if (memcmp(data + HEADER_SIZE, this->key, this->keyLen) != 0) return false;
+	/* chunks */
+	uint64_t members = 0;
+	for (size_t pos = HEADER_SIZE + this->keyLen; (size - pos) >= CHUNK_SIZE; ) {
+		const uint64_t memberCount = rd32(data + pos);
+		const uint64_t symbolCount = rd32(data + pos + 4);
+		const uint64_t textSize = rd64(data + pos + 8);
+		pos += CHUNK_SIZE;
+		if (memberCount == 0 && symbolCount == 0 && textSize == 0) return pos == size;
+		if ((symbolCount * RECORD_SIZE) > (size - pos)) return false;
+		/* member indices */
+		members += memberCount;
+		const unsigned char * record = data + pos;
+		for (uint64_t i = 0; i < symbolCount; i++, record += RECORD_SIZE) {
+			int32_t member;
+			memcpy(&member, record + RECORD_MEMBER_POS, sizeof(member));
+			if (member < -1 || (member >= 0 && uint64_t(member) >= members)) return false;
+		}
+		pos += size_t(symbolCount * RECORD_SIZE);
+		/* text needs to hold exactly the given number of null-terminated strings */
+		if (textSize > (size - pos)) return false;
+		const char * text = reinterpret_cast<const char *>(data + pos);
+		const char * textEnd = text + textSize;
+		uint64_t strings = 0;
+		for (const char * str = text; str < textEnd; strings++) {
+			const char * end = static_cast<const char *>(memchr(str, 0, size_t(textEnd - str)));
+			if (end == NULL) return false;
+			str = end + 1;
+		}
+		if (strings != (memberCount + symbolCount)) return false;
+		pos += size_t(textSize);
+	}
+	return false;
+}
+
+
+} /* namespace gui */
+} /* namespace pcf */
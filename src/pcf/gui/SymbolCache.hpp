@@ -0,0 +1,69 @@
+/**
+ * @file SymbolCache.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __PCF_GUI_SYMBOLCACHE_HPP__
+#define __PCF_GUI_SYMBOLCACHE_HPP__
+
+#include <cstdio>
+#include <pcf/gui/SymbolViewer.hpp>
+
+
+extern "C" {
+#include <libpcf/mfile.h>
+}
+
+
+namespace pcf {
+namespace gui {
+
+
+/**
+ * Persistent on-disk cache of the parsed and demangled symbol list of a
+ * binary. There is one cache file per binary path, nm path and load options.
+ * The file is only used if the identity of the binary and nm (size and
+ * modification time or ELF build ID) still match.
+ * The symbols are stored in the chunks passed to write() and returned in the
+ * same order by read().
+ */
+class SymbolCache {
+private:
+	char * path; /* cache file path */
+	char * tmpPath; /* temporary cache file path while writing */
+	char * key; /* identity of the cached data */
+	size_t keyLen;
+	tMFile * input;
+	size_t inputPos;
+	FILE * output;
+public:
+	explicit SymbolCache(const char * aDirectory, const char * aNmPath, const char * aBinPath, const char * aOptions);
+	~SymbolCache();
+
+	static char * getDefaultDirectory();
+
+	bool isValid() const { return this->path != NULL && this->key != NULL; }
+	bool isWriting() const { return this->output != NULL; }
+
+	bool openRead();
+	bool read(SymbolList & symbols, SymbolViewer::MemberList & members);
+	bool openWrite();
+	bool write(const SymbolList & symbols, const SymbolViewer::MemberList & members);
+	bool commit();
+	void abort();
+private:
+	SymbolCache(const SymbolCache &);
+	SymbolCache & operator= (const SymbolCache &);
+
+	void closeRead();
+	bool validate() const;
+};
+
+
+} /* namespace gui */
+} /* namespace pcf */
+
+
+#endif /* __PCF_GUI_SYMBOLCACHE_HPP__ */
@@ -0,0 +1,255 @@
+/**
+ * @file SymbolList.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#include <algorithm>
+#include <pcf/gui/SymbolList.hpp>
+
+
+namespace pcf {
+namespace gui {
+namespace {
+
+
+/**
+ * Less-than comparer for symbol indices in reverse order by size.
+ */
+class BySizeReverseOrder {
+private:
+	const std::vector<long long int> & sizes;
+public:
+	explicit BySizeReverseOrder(const std::vector<long long int> & aSizes):
+		sizes(aSizes)
+	{}
+
+	bool operator() (const size_t lhs, const size_t rhs) const {
+		return this->sizes[lhs] > this->sizes[rhs];
+	}
+};
+
+
+/**
+ * Reorders the given column.
+ *
+ * @param[in,out] column - column to reorder
+ * @param[in] order - new order given as old indices
+ * @tparam T - column element type
+ */
+template <typename T>
+void permuteColumn(std::vector<T> & column, const std::vector<size_t> & order) {
+	std::vector<T> result;
+	result.reserve(column.size());
+	for (std::vector<size_t>::const_iterator it = order.begin(); it != order.end(); ++it) {
+		result.push_back(column[*it]);
+	}
+	column.swap(result);
+}
+
+
+} /* anonymous namespace */
+
+
+/**
+ * Reserves space for the given number of symbols.
+ *
+ * @param[in] count - number of symbols
+ */
+void SymbolList::reserve(const size_t count) {
+	this->types.reserve(count);
+	this->sizes.reserve(count);
+	this->addresses.reserve(count);
+	this->members.reserve(count);
+	this->nameOffsets.reserve(count);
+}
+
+
+/**
+ * Adds a symbol at the end of the list. The name is copied.
+ *
+ * @param[in] type - symbol type
+ * @param[in] size - symbol size in bytes
+ * @param[in] address - symbol address
+ * @param[in] name - symbol name (does not need to be null-terminated)
+ * @param[in] nameLen - symbol name length in bytes
+ * @param[in] member - archive member index or -1
+ * @return true on success, false on allocation error
+ */
+bool SymbolList::push_back(const char type, const long long int size, const boost::uint64_t address, const char * name, const size_t nameLen, const int member) {
+	const boost::uint32_t offset = this->names.intern(name, nameLen);
+	if (offset == StringPool::INVALID) return false;
+	this->types.push_back(type);
+	this->sizes.push_back(size);
+	this->addresses.push_back(address);
+	this->members.push_back(member);
+	this->nameOffsets.push_back(offset);
+	return true;
+}
+
+
+/**
+ * Moves all symbols of the given list to the end of this list.
+ *
+ * @param[in,out] other - list to append; empty afterwards
+ * @return true on success, false on allocation error
+ */
+bool SymbolList::append(SymbolList & other) {
+	if ( this->empty() ) {
+		this->swap(other);
+		other.clear();
+		return true;
+	}
+	/* names equal to ones of this list share their storage */
+	OffsetList offsets;
+	offsets.reserve(other.size());
+	for (size_t i = 0; i < other.size(); i++) {
+		const boost::uint32_t offset = this->names.intern(other.getName(i));
+		if (offset == StringPool::INVALID) return false;
+		offsets.push_back(offset);
+	}
+	this->types.insert(this->types.end(), other.types.begin(), other.types.end());
+	this->sizes.insert(this->sizes.end(), other.sizes.begin(), other.sizes.end());
+	this->addresses.insert(this->addresses.end(), other.addresses.begin(), other.addresses.end());
+	this->members.insert(this->members.end(), other.members.begin(), other.members.end());
+	this->nameOffsets.insert(this->nameOffsets.end(), offsets.begin(), offsets.end());
+	other.clear();
+	return true;
+}
+
+
+/**
+ * Merges the given list into this list. Both lists need to be sorted by size
+ * in descending order. Symbols of this list come first for equal sizes.
+ *
+ * @param[in,out] other - list to merge; empty afterwards
+ * @return true on success, false on allocation error
+ */
+bool SymbolList::merge(SymbolList & other) {
+	if ( this->empty() ) {
+		this->swap(other);
+		other.clear();
+		return true;
+	}
+	/* names equal to ones of this list share their storage */
+	OffsetList offsets;
+	offsets.reserve(other.size());
+	for (size_t i = 0; i < other.size(); i++) {
+		const boost::uint32_t offset = this->names.intern(other.getName(i));
+		if (offset == StringPool::INVALID) return false;
+		offsets.push_back(offset);
+	}
+	const size_t lhsCount = this->size();
+	const size_t rhsCount = other.size();
+	SymbolList merged;
+	merged.reserve(lhsCount + rhsCount);
+	size_t lhs = 0, rhs = 0;
+	while (lhs < lhsCount || rhs < rhsCount) {
+		if (rhs >= rhsCount || (lhs < lhsCount && this->sizes[lhs] >= other.sizes[rhs])) {
+			merged.types.push_back(this->types[lhs]);
+			merged.sizes.push_back(this->sizes[lhs]);
+			merged.addresses.push_back(this->addresses[lhs]);
+			merged.members.push_back(this->members[lhs]);
+			merged.nameOffsets.push_back(this->nameOffsets[lhs]);
+			lhs++;
+		} else {
+			merged.types.push_back(other.types[rhs]);
+			merged.sizes.push_back(other.sizes[rhs]);
+			merged.addresses.push_back(other.addresses[rhs]);
+			merged.members.push_back(other.members[rhs]);
+			merged.nameOffsets.push_back(offsets[rhs]);
+			rhs++;
+		}
+	}
+	merged.names.swap(this->names);
+	this->swap(merged);
+	other.clear();
+	return true;
+}
+
+
+/**
+ * Replaces the content of this list with a copy of the given one.
+ *
+ * @param[in] other - list to copy
+ */
+void SymbolList::assign(const SymbolList & other) {
+	this->types = other.types;
+	this->sizes = other.sizes;
+	this->addresses = other.addresses;
+	this->members = other.members;
+	this->nameOffsets = other.nameOffsets;
+	this->names.assign(other.names);
+}
+
+
+/**
+ * Sorts the symbols by size in descending order. The order of symbols with
+ * equal size is kept.
+ */
+void SymbolList::sortBySize() {
+	std::vector<size_t> order(this->size());
+	for (size_t i = 0; i < order.size(); i++) order[i] = i;
+	std::stable_sort(order.begin(), order.end(), BySizeReverseOrder(this->sizes));
+	this->permute(order);
+}
+
+
+/**
+ * Replaces the names of all symbols. The given pool needs to hold the names
+ * referenced by the given offsets which are ordered like the symbols.
+ *
+ * @param[in,out] pool - new name pool; receives the previous names
+ * @param[in,out] offsets - new name offsets; receives the previous offsets
+ */
+void SymbolList::swapNames(StringPool & pool, OffsetList & offsets) {
+	this->names.swap(pool);
+	this->nameOffsets.swap(offsets);
+}
+
+
+/**
+ * Swaps the content of this list with the given one.
+ *
+ * @param[in,out] other - swap with this list
+ */
+void SymbolList::swap(SymbolList & other) {
+	this->types.swap(other.types);
+	this->sizes.swap(other.sizes);
+	this->addresses.swap(other.addresses);
+	this->members.swap(other.members);
+	this->nameOffsets.swap(other.nameOffsets);
+	this->names.swap(other.names);
+}
+
+
+/**
+ * Removes all symbols and frees the allocated memory.
+ */
+void SymbolList::clear() {
+	std::vector<char>().swap(this->types);
+	std::vector<long long int>().swap(this->sizes);
+	std::vector<boost::uint64_t>().swap(this->addresses);
+	std::vector<int>().swap(this->members);
+	OffsetList().swap(this->nameOffsets);
+	this->names.clear();
+}
+
+
+/**
+ * Reorders all columns.
+ *
+ * @param[in] order - new order given as old indices
+ */
+void SymbolList::permute(const std::vector<size_t> & order) {
+	permuteColumn(this->types, order);
+	permuteColumn(this->sizes, order);
+	permuteColumn(this->addresses, order);
+	permuteColumn(this->members, order);
+	permuteColumn(this->nameOffsets, order);
+}
+
+
+} /* namespace gui */
+} /* namespace pcf */
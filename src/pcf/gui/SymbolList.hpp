@@ -0,0 +1,89 @@
+/**
+ * @file SymbolList.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __PCF_GUI_SYMBOLLIST_HPP__
+#define __PCF_GUI_SYMBOLLIST_HPP__
+
+#include <vector>
+#include <pcf/gui/StringPool.hpp>
+#include <pcf/Utility.hpp>
+
+
+namespace pcf {
+namespace gui {
+
+
+/**
+ * Columnar symbol store. Each symbol property is kept in its own column. The
+ * symbol names are stored in a contiguous string pool and referenced by their
+ * offset. Scanning a single property therefore only touches the memory of
+ * that column.
+ */
+class SymbolList {
+public:
+	typedef std::vector<boost::uint32_t> OffsetList;
+private:
+	std::vector<char> types;
+	std::vector<long long int> sizes;
+	std::vector<boost::uint64_t> addresses;
+	std::vector<int> members; /* index into the member list or -1 if not from an archive */
+	OffsetList nameOffsets;
+	StringPool names;
+public:
+	explicit SymbolList() {}
+
+	/** @return number of symbols */
+	size_t size() const { return this->types.size(); }
+	/** @return true if the list holds no symbols */
+	bool empty() const { return this->types.empty(); }
+
+	/** @return type column */
+	const std::vector<char> & getTypes() const { return this->types; }
+	/** @return size column */
+	const std::vector<long long int> & getSizes() const { return this->sizes; }
+	/** @return address column */
+	const std::vector<boost::uint64_t> & getAddresses() const { return this->addresses; }
+	/** @return member column */
+	const std::vector<int> & getMembers() const { return this->members; }
+	/** @return name offset column */
+	const OffsetList & getNameOffsets() const { return this->nameOffsets; }
+	/** @return name pool referenced by the name offset column */
+	const StringPool & getNames() const { return this->names; }
+
+	/** @return type of the symbol at the given index */
+	char getType(const size_t i) const { return this->types[i]; }
+	/** @return size of the symbol at the given index */
+	long long int getSize(const size_t i) const { return this->sizes[i]; }
+	/** @return address of the symbol at the given index */
+	boost::uint64_t getAddress(const size_t i) const { return this->addresses[i]; }
+	/** @return member index of the symbol at the given index */
+	int getMember(const size_t i) const { return this->members[i]; }
+	/** @return name of the symbol at the given index */
+	const char * getName(const size_t i) const { return this->names.get(this->nameOffsets[i]); }
+
+	void reserve(const size_t count);
+	bool push_back(const char type, const long long int size, const boost::uint64_t address, const char * name, const size_t nameLen, const int member);
+	bool append(SymbolList & other);
+	bool merge(SymbolList & other);
+	void assign(const SymbolList & other);
+	void sortBySize();
+	void swapNames(StringPool & pool, OffsetList & offsets);
+	void swap(SymbolList & other);
+	void clear();
+private:
+	SymbolList(const SymbolList &);
+	SymbolList & operator= (const SymbolList &);
+
+	void permute(const std::vector<size_t> & order);
+};
+
+
+} /* namespace gui */
+} /* namespace pcf */
+
+
+#endif /* __PCF_GUI_SYMBOLLIST_HPP__ */
@@ -0,0 +1,716 @@
+/**
+ * @file SymbolLoader.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ * @remarks nm -S --size-sort -f bsd -t d <file>
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <FL/filename.H>
+#include <pcf/gui/Demangler.hpp>
+#include <pcf/gui/SymbolCache.hpp>
+#include <pcf/gui/SymbolLoader.hpp>
+
+
+extern "C" {
+#include <libpcf/arfile.h>
+#include <libpcf/elfsym.h>
+#include <libpcf/fdios.h>
+#include <libpcf/mfile.h>
+#include <libpcf/nmline.h>
+#ifdef PCF_IS_WIN
+#include <libpcf/fdious.h>
+#endif
+}
+
+
+namespace pcf {
+namespace gui {
+namespace {
+
+
+/** Number of symbols after which a batch is passed to the next stage. */
+static const size_t BATCH_SYMBOLS = 16384;
+/** Number of nm output bytes after which a batch is passed to the next stage. */
+static const size_t BATCH_TEXT = 0x40000;
+/** Number of batches which can be queued between two stages. */
+static const size_t QUEUE_SIZE = 16;
+/** Minimal time between two batches passed to the GUI thread in milliseconds. */
+static const uint64_t POST_INTERVAL = 100;
+/**
+ * The time between two batches passed to the GUI thread is at least this
+ * factor times the time needed to create the last one.
+ */
+static const uint64_t POST_COST_FACTOR = 4;
+
+
+/**
+ * Returns a null-terminated copy of the given string.
+ *
+ * @param[in] str - string to copy
+ * @param[in] len - string length in bytes
+ * @return newly allocated copy or NULL on allocation error
+ */
+inline char * copyString(const char * str, const size_t len) {
+	char * result = static_cast<char *>(malloc(sizeof(char) * (len + 1)));
+	if (result == NULL) return NULL;
+	memcpy(result, str, sizeof(char) * len);
+	result[len] = 0;
+	return result;
+}
+
+
+/**
+ * Appends a new symbol to the given list. The symbol name is demangled if requested.
+ *
+ * @param[in,out] list - append to this list
+ * @param[in] type - symbol type
+ * @param[in] size - symbol size
+ * @param[in] name - symbol name (does not need to be null-terminated)
+ * @param[in] nameLen - symbol name length in bytes
+ * @param[in] member - archive member index or -1
+ * @param[in,out] demangler - demangle symbol name with this demangler or NULL
+ * @param[in,out] ctx - demangler context of the calling thread
+ */
+void appendSymbol(SymbolList & list, const char type, const long long int size, const uint64_t address, const char * name, const size_t nameLen, const int member, Demangler * demangler = NULL, Demangler::Context * ctx = NULL) {
+	const char * newName = (demangler != NULL) ? demangler->demangle(name, *ctx) : NULL;
+	/* the symbol is skipped if out of memory */
+	if (newName != NULL) {
+		list.push_back(type, size, address, newName, strlen(newName), member);
+	} else {
+		list.push_back(type, size, address, name, nameLen, member);
+	}
+}
+
+
+/**
+ * Context passed to the ELF symbol reader callback.
+ */
+struct ElfReaderContext {
+	SymbolList & list;
+	const int member;
+	Demangler * demangler;
+	Demangler::Context & demanglerContext;
+
+	explicit ElfReaderContext(SymbolList & aList, const int aMember, Demangler * aDemangler, Demangler::Context & aDemanglerContext):
+		list(aList),
+		member(aMember),
+		demangler(aDemangler),
+		demanglerContext(aDemanglerContext)
+	{}
+};
+
+
+/**
+ * Callback for elfsym_read() to add the passed symbol to the symbol list.
+ *
+ * @param[in] sym - symbol found
+ * @param[in] param - pointer to ElfReaderContext
+ * @return 1 to continue
+ */
+int onElfSymbol(const tElfSymbol * sym, void * param) {
+	ElfReaderContext * ctx = static_cast<ElfReaderContext *>(param);
+	appendSymbol(ctx->list, sym->type, static_cast<long long int>(sym->size), sym->value, sym->name, strlen(sym->name), ctx->member, ctx->demangler, &(ctx->demanglerContext));
+	return 1;
+}
+
+
+/**
+ * Context shared by all archive reader worker threads.
+ */
+struct ArchiveReaderContext {
+	const tArIndex & index;
+	Demangler * demangler; /* NULL to keep the names mangled */
+	const volatile int & cancelled;
+	volatile size_t next; /* next member to process */
+	std::vector<SymbolList *> results; /* symbols per member */
+
+	explicit ArchiveReaderContext(const tArIndex & aIndex, Demangler * aDemangler, const volatile int & aCancelled):
+		index(aIndex),
+		demangler(aDemangler),
+		cancelled(aCancelled),
+		next(0),
+		results(aIndex.count, NULL)
+	{
+		for (std::vector<SymbolList *>::iterator it = this->results.begin(); it != this->results.end(); ++it) {
+			*it = new SymbolList();
+		}
+	}
+
+	~ArchiveReaderContext() {
+		for (std::vector<SymbolList *>::iterator it = this->results.begin(); it != this->results.end(); ++it) {
+			delete *it;
+		}
+	}
+private:
+	ArchiveReaderContext(const ArchiveReaderContext &);
+	ArchiveReaderContext & operator= (const ArchiveReaderContext &);
+};
+
+
+/**
+ * Worker thread function which reads the symbol tables of the archive members
+ * until all members have been processed.
+ *
+ * @param[in,out] param - pointer to ArchiveReaderContext
+ */
+void archiveReaderWorker(void * param) {
+	ArchiveReaderContext * ctx = static_cast<ArchiveReaderContext *>(param);
+	Demangler::Context demanglerContext;
+	for (;;) {
+		const size_t i = thread_fetchAdd(&(ctx->next), 1);
+		if (i >= ctx->index.count) break;
+		if (__atomic_load_n(&(ctx->cancelled), __ATOMIC_ACQUIRE) != 0) break;
+		const tArMember & member = ctx->index.members[i];
+		ElfReaderContext elfCtx(*(ctx->results[i]), int(i), ctx->demangler, demanglerContext);
+		elfsym_read(member.data, member.size, onElfSymbol, &elfCtx);
+	}
+}
+
+
+/**
+ * Context passed to the ELF symbol reader callback of the reader stage.
+ */
+struct ElfBatchContext {
+	SymbolLoader & loader;
+	SymbolLoader::Batch * batch; /* current batch */
+	size_t emitted; /* number of batches passed to the next stage */
+
+	explicit ElfBatchContext(SymbolLoader & aLoader):
+		loader(aLoader),
+		batch(NULL),
+		emitted(0)
+	{}
+};
+
+
+} /* anonymous namespace */
+
+
+/**
+ * Constructor.
+ *
+ * @param[in] aId - load identifier passed with each batch
+ * @param[in] aNmPath - path to nm
+ * @param[in] aBinPath - path to the binary to load
+ * @param[in] aDemangle - demangle symbol names?
+ * @param[in] aNativeReader - try to read the symbol tables without nm first?
+ * @param[in] aCacheDir - symbol cache directory or NULL to disable the cache
+ * @param[in] aHandler - called within the GUI thread for each Batch
+ * @param[in] aUserData - passed within each Batch
+ */
+SymbolLoader::SymbolLoader(const size_t aId, const char * aNmPath, const char * aBinPath, const bool aDemangle, const bool aNativeReader, const char * aCacheDir, Fl_Awake_Handler aHandler, void * aUserData):
+	id(aId),
+	nmPath(strdup(aNmPath)),
+	binPath(strdup(aBinPath)),
+	demangle(aDemangle),
+	nativeReader(aNativeReader),
+	cacheDir((aCacheDir != NULL) ? strdup(aCacheDir) : NULL),
+	cache(NULL),
+	demangler(NULL),
+	handler(aHandler),
+	userData(aUserData),
+	parseQueue(spsc_create(QUEUE_SIZE)),
+	storeQueue(spsc_create(QUEUE_SIZE)),
+	reader(NULL),
+	parser(NULL),
+	store(NULL),
+	cancelled(0),
+	childMutex(thread_mutexCreate()),
+	child(NULL),
+	firstLine(NULL)
+{}
+
+
+/**
+ * Destructor. Cancels a running load and waits for all stages to finish.
+ */
+SymbolLoader::~SymbolLoader() {
+	this->cancel();
+	thread_join(this->reader);
+	thread_join(this->parser);
+	thread_join(this->store);
+	/* free batches left over */
+	void * item;
+	if (this->parseQueue != NULL) {
+		while (spsc_pop(this->parseQueue, &item) != 0) delete static_cast<Batch *>(item);
+		spsc_free(this->parseQueue);
+	}
+	if (this->storeQueue != NULL) {
+		while (spsc_pop(this->storeQueue, &item) != 0) delete static_cast<Batch *>(item);
+		spsc_free(this->storeQueue);
+	}
+	if (this->nmPath != NULL) free(this->nmPath);
+	if (this->binPath != NULL) free(this->binPath);
+	if (this->cacheDir != NULL) free(this->cacheDir);
+	if (this->cache != NULL) delete this->cache; /* removes incomplete cache files */
+	if (this->demangler != NULL) delete this->demangler;
+	if (this->firstLine != NULL) free(this->firstLine);
+	thread_mutexFree(this->childMutex);
+}
+
+
+/**
+ * Starts all stages.
+ *
+ * @return true on success, else false
+ */
+bool SymbolLoader::start() {
+	if (this->nmPath == NULL || this->binPath == NULL || this->parseQueue == NULL || this->storeQueue == NULL || this->childMutex == NULL) return false;
+	if (this->reader != NULL) return false;
+	if ( this->demangle ) this->demangler = new Demangler();
+	this->store = thread_create(SymbolLoader::storeMain, this);
+	if (this->store == NULL) return false;
+	this->parser = thread_create(SymbolLoader::parserMain, this);
+	if (this->parser == NULL) return false;
+	this->reader = thread_create(SymbolLoader::readerMain, this);
+	return this->reader != NULL;
+}
+
+
+/**
+ * Cancels the load without waiting for the stages to finish. A running nm
+ * process gets killed. No more batches are passed to the handler afterwards.
+ */
+void SymbolLoader::cancel() {
+	__atomic_store_n(&(this->cancelled), 1, __ATOMIC_RELEASE);
+	this->stopStages();
+}
+
+
+/**
+ * Stops the reader and parser stages and kills a running nm process. Batches
+ * already passed on are kept.
+ */
+void SymbolLoader::stopStages() {
+	if (this->parseQueue != NULL) spsc_close(this->parseQueue);
+	if (this->storeQueue != NULL) spsc_close(this->storeQueue);
+	thread_mutexLock(this->childMutex);
+	if (this->child != NULL) fdio_pkill(this->child);
+	thread_mutexUnlock(this->childMutex);
+}
+
+
+/**
+ * Reader stage thread function. The symbol cache is tried first, followed by
+ * the native reader. A new cache file is written by the store stage on cache
+ * miss.
+ *
+ * @param[in,out] param - pointer to SymbolLoader
+ */
+void SymbolLoader::readerMain(void * param) {
+	SymbolLoader * self = static_cast<SymbolLoader *>(param);
+	if (( ! self->readCache() ) && ( ! self->isCancelled() )) {
+		if (( ! self->nativeReader ) || ( ! self->readNative() )) {
+			if ( ! self->isCancelled() ) self->readNm();
+		}
+	}
+	spsc_close(self->parseQueue);
+}
+
+
+/**
+ * Parser stage thread function. Parses the nm output lines and demangles the
+ * symbol names if not already done.
+ *
+ * @param[in,out] param - pointer to SymbolLoader
+ */
+void SymbolLoader::parserMain(void * param) {
+	SymbolLoader * self = static_cast<SymbolLoader *>(param);
+	size_t members = 0; /* number of archive members found so far */
+	void * item;
+	while (spsc_popWait(self->parseQueue, &item) != 0) {
+		Batch * batch = static_cast<Batch *>(item);
+		if ( ! batch->text.empty() ) {
+			/* parse nm output lines */
+			const char * textEnd = &(batch->text[0]) + batch->text.size();
+			tNmLine fields;
+			for (const char * line = &(batch->text[0]); line < textEnd; ) {
+				const size_t len = strlen(line);
+				if (self->firstLine == NULL) self->firstLine = copyString(line, len);
+				switch (nmline_parse(line, len, 10, &fields)) {
+				case NMLINE_SYMBOL:
+					appendSymbol(batch->symbols, fields.type, fields.size, static_cast<uint64_t>(fields.value), fields.name, fields.nameLen, int(members + batch->members.size()) - 1);
+					break;
+				case NMLINE_MEMBER:
+					batch->members.push_back(copyString(fields.name, fields.nameLen));
+					break;
+				default:
+					break;
+				}
+				line += len + 1;
+			}
+			std::vector<char>().swap(batch->text);
+		}
+		if (self->demangler != NULL && ( ! batch->demangled )) {
+			/* demangle parsed and natively read symbols in parallel */
+			self->demangler->demangle(batch->symbols);
+		}
+		batch->demangled = true;
+		members += batch->members.size();
+		if (spsc_pushWait(self->storeQueue, batch) == 0) delete batch;
+	}
+	spsc_close(self->storeQueue);
+}
+
+
+/**
+ * Store stage thread function. Sorts the symbols by size in descending order
+ * and merges them into the list of all symbols loaded so far. The GUI thread
+ * periodically receives a copy of this list which replaces the displayed one.
+ * The last batch takes over the list itself.
+ *
+ * @param[in,out] param - pointer to SymbolLoader
+ */
+void SymbolLoader::storeMain(void * param) {
+	SymbolLoader * self = static_cast<SymbolLoader *>(param);
+	SymbolList all; /* all symbols passed to the GUI thread so far */
+	Batch * pending = NULL;
+	bool ok = true;
+	uint64_t interval = POST_INTERVAL;
+	uint64_t lastPost = thread_ticks();
+	void * item;
+	while (ok && spsc_popWait(self->storeQueue, &item) != 0) {
+		Batch * batch = static_cast<Batch *>(item);
+		batch->symbols.sortBySize();
+		if (self->cache != NULL && self->cache->isWriting()) self->cache->write(batch->symbols, batch->members);
+		if (pending == NULL) {
+			pending = batch;
+		} else {
+			/* merge into the pending batch */
+			ok = pending->symbols.merge(batch->symbols);
+			pending->members.insert(pending->members.end(), batch->members.begin(), batch->members.end());
+			batch->members.clear();
+			delete batch;
+		}
+		const uint64_t now = thread_ticks();
+		if (ok && (now - lastPost) >= interval) {
+			/* pass a copy of all symbols; the GUI thread only swaps it in */
+			ok = all.merge(pending->symbols);
+			if ( ok ) {
+				pending->symbols.assign(all);
+				self->post(pending);
+				pending = NULL;
+				lastPost = thread_ticks();
+				interval = std::max(POST_INTERVAL, POST_COST_FACTOR * (lastPost - now));
+			}
+		}
+	}
+	if ( self->isCancelled() ) {
+		if (pending != NULL) delete pending;
+		return;
+	}
+	if (pending == NULL) pending = new Batch(self->id, self->userData);
+	if ( ok ) ok = all.merge(pending->symbols);
+	if ( ! ok ) {
+		/* the symbol names exceed the name pool; stop the other stages */
+		self->stopStages();
+		all.clear();
+		pending->symbols.clear();
+	}
+	/* complete the cache file; failed loads are not cached */
+	if (self->cache != NULL && self->cache->isWriting()) {
+		if ( ! all.empty() ) {
+			self->cache->commit();
+		} else {
+			self->cache->abort();
+		}
+	}
+	/* pass the last batch with all symbols */
+	pending->symbols.swap(all);
+	pending->done = true;
+	if ( ok ) {
+		pending->error = self->firstLine;
+		self->firstLine = NULL;
+	} else {
+		pending->error = strdup("Too many symbol names.");
+	}
+	self->post(pending);
+}
+
+
+/**
+ * Reads the symbol list from the symbol cache. A new cache file is opened for
+ * writing if no matching one exists.
+ *
+ * @return true on cache hit, else false
+ */
+bool SymbolLoader::readCache() {
+	if (this->cacheDir == NULL) return false;
+	char options[64];
+	snprintf(options, sizeof(options), "-S --size-sort -f bsd -t d demangle=%i native=%i", int(this->demangle), int(this->nativeReader));
+	this->cache = new SymbolCache(this->cacheDir, this->nmPath, this->binPath, options);
+	if ( ! this->cache->openRead() ) {
+		this->cache->openWrite();
+		return false;
+	}
+	for (;;) {
+		Batch * batch = new Batch(this->id, this->userData);
+		batch->demangled = true;
+		if ( ! this->cache->read(batch->symbols, batch->members) ) {
+			delete batch;
+			break;
+		}
+		if ( ! this->emit(batch) ) break;
+	}
+	return true;
+}
+
+
+/**
+ * Reads the symbol list from the binary file by parsing its ELF symbol table
+ * directly. Archives of ELF objects are supported as well.
+ *
+ * @return true on success, false if the format is not supported or no symbols were found
+ */
+bool SymbolLoader::readNative() {
+	bool result = false;
+	tMFile * bin = mfile_open(this->binPath);
+	if (bin == NULL) return false;
+	if ( elfsym_isElf(bin->ptr, bin->size) ) {
+		ElfBatchContext ctx(*this);
+		const bool success = elfsym_read(bin->ptr, bin->size, SymbolLoader::onElfSymbol, &ctx) > 0;
+		/* partial results cannot be replaced by nm anymore */
+		result = success || ctx.emitted > 0;
+		if (ctx.batch != NULL) {
+			if ( result ) {
+				this->emit(ctx.batch);
+			} else {
+				delete ctx.batch;
+			}
+		}
+	} else if ( arfile_isArchive(bin->ptr, bin->size) ) {
+		result = this->readArchive(bin->ptr, bin->size);
+	}
+	mfile_close(bin);
+	return result;
+}
+
+
+/**
+ * Callback for elfsym_read() to add the passed symbol to the current batch of
+ * the reader stage. Full batches are passed on to the parser stage.
+ *
+ * @param[in] sym - symbol found
+ * @param[in] param - pointer to ElfBatchContext
+ * @return 1 to continue, 0 if the load was cancelled
+ */
+int SymbolLoader::onElfSymbol(const tElfSymbol * sym, void * param) {
+	ElfBatchContext * ctx = static_cast<ElfBatchContext *>(param);
+	SymbolLoader & self = ctx->loader;
+	if (ctx->batch == NULL) {
+		ctx->batch = new Batch(self.id, self.userData);
+		ctx->batch->symbols.reserve(BATCH_SYMBOLS);
+	}
+	appendSymbol(ctx->batch->symbols, sym->type, static_cast<long long int>(sym->size), sym->value, sym->name, strlen(sym->name), -1);
+	if (ctx->batch->symbols.size() >= BATCH_SYMBOLS) {
+		Batch * full = ctx->batch;
+		ctx->batch = NULL;
+		if ( ! self.emit(full) ) return 0;
+		ctx->emitted++;
+	}
+	return 1;
+}
+
+
+/**
+ * Reads the symbol lists of all archive members. The members are distributed
+ * over one worker thread per processor and passed on in archive order afterwards.
+ *
+ * @param[in] data - archive content
+ * @param[in] size - archive size in bytes
+ * @return true on success, false if a member format is not supported or no symbols were found
+ */
+bool SymbolLoader::readArchive(const void * data, const size_t size) {
+	tArIndex * index = arfile_index(data, size);
+	if (index == NULL) return false;
+	/* fall back to nm if any member is not understood */
+	for (size_t i = 0; i < index->count; i++) {
+		if ( ! elfsym_isElf(index->members[i].data, index->members[i].size) ) {
+			arfile_free(index);
+			return false;
+		}
+	}
+	/* read members in parallel */
+	ArchiveReaderContext ctx(*index, this->demangler, this->cancelled);
+	std::vector<tThread *> workers;
+	const size_t workerCount = std::min(thread_cpuCount(), index->count);
+	for (size_t i = 1; i < workerCount; i++) {
+		tThread * worker = thread_create(archiveReaderWorker, &ctx);
+		if (worker == NULL) break;
+		workers.push_back(worker);
+	}
+	archiveReaderWorker(&ctx);
+	for (std::vector<tThread *>::iterator it = workers.begin(); it != workers.end(); ++it) {
+		thread_join(*it);
+	}
+	if ( this->isCancelled() ) {
+		arfile_free(index);
+		return true;
+	}
+	/* pass on results in archive order */
+	size_t total = 0;
+	for (size_t i = 0; i < index->count; i++) total += ctx.results[i]->size();
+	if (total > 0) {
+		Batch * batch = NULL;
+		for (size_t i = 0; i < index->count; i++) {
+			if (batch == NULL) {
+				batch = new Batch(this->id, this->userData);
+				batch->demangled = true;
+			}
+			batch->members.push_back(strdup(index->members[i].name));
+			batch->symbols.append(*(ctx.results[i]));
+			if (batch->symbols.size() >= BATCH_SYMBOLS || (i + 1) >= index->count) {
+				if ( ! this->emit(batch) ) break;
+				batch = NULL;
+			}
+		}
+	}
+	arfile_free(index);
+	return total > 0;
+}
+
+
+/**
+ * Reads the symbol list from the binary file via nm. The output lines are
+ * passed on unparsed.
+ */
+void SymbolLoader::readNm() {
+#ifdef PCF_IS_WIN
+	/* convert nm path to UTF-16 */
+	const size_t nmPathLen = strlen(this->nmPath);
+	const unsigned nmPathWLen = fl_utf8toUtf16(this->nmPath, static_cast<unsigned>(nmPathLen), NULL, 0) + 1;
+	wchar_t * nmPathW = static_cast<wchar_t *>(malloc(sizeof(wchar_t) * nmPathWLen));
+	if (nmPathW == NULL) return;
+	nmPathW[fl_utf8toUtf16(this->nmPath, static_cast<unsigned>(nmPathLen), reinterpret_cast<unsigned short *>(nmPathW), nmPathWLen)] = 0;
+	/* convert binary path to UTF-16 */
+	const size_t binPathLen = strlen(this->binPath);
+	const unsigned binPathWLen = fl_utf8toUtf16(this->binPath, static_cast<unsigned>(binPathLen), NULL, 0) + 1;
+	wchar_t * binPathW = static_cast<wchar_t *>(malloc(sizeof(wchar_t) * binPathWLen));
+	if (binPathW == NULL) {
+		free(nmPathW);
+		return;
+	}
+	binPathW[fl_utf8toUtf16(this->binPath, static_cast<unsigned>(binPathLen), reinterpret_cast<unsigned short *>(binPathW), binPathWLen)] = 0;
+	/* build command-line */
+	const wchar_t * cmdW[] = {
+		nmPathW + fl_utf8toUtf16(this->nmPath, static_cast<unsigned>(nmPathLen - strlen(fl_filename_name(this->nmPath))), NULL, 0),
+		L"-S",
+		L"--size-sort",
+		L"-f",
+		L"bsd",
+		L"-t",
+		L"d",
+		binPathW,
+		NULL
+	};
+	/* call nm */
+	tFdioPHandle * nm = fdious_popen(nmPathW, cmdW, NULL, NULL, tFdioPMode(FDIO_USE_STDOUT | FDIO_COMBINE));
+#else /* not Windows */
+	/* build command-line */
+	const char * cmd[] = {
+		fl_filename_name(this->nmPath),
+		"-S",
+		"--size-sort",
+		"-f",
+		"bsd",
+		"-t",
+		"d",
+		this->binPath,
+		NULL
+	};
+	/* call nm */
+	tFdioPHandle * nm = fdios_popen(this->nmPath, cmd, NULL, NULL, tFdioPMode(FDIO_USE_STDOUT | FDIO_COMBINE));
+#endif /* not Windows */
+	/* pass on nm output lines */
+	tFdiosLineReader * lr = (nm != NULL && this->setChild(nm)) ? fdios_lineReaderCreate(nm->out, 0) : NULL;
+	if (lr != NULL) {
+		Batch * batch = NULL;
+		char * line = NULL;
+		size_t len;
+		while (fdios_lineReaderGet(lr, &line, &len) > 0) {
+			if (len == 0) continue; /* ignore empty lines */
+			if (batch == NULL) {
+				batch = new Batch(this->id, this->userData);
+				batch->text.reserve(BATCH_TEXT + 256);
+			}
+			batch->text.insert(batch->text.end(), line, line + len + 1);
+			if (batch->text.size() >= BATCH_TEXT) {
+				Batch * full = batch;
+				batch = NULL;
+				if ( ! this->emit(full) ) break;
+			}
+		}
+		if (batch != NULL) this->emit(batch);
+		fdios_lineReaderFree(lr);
+	}
+	this->setChild(NULL);
+#ifdef PCF_IS_WIN
+	if (nm != NULL) fdious_pclose(nm);
+	free(nmPathW);
+	free(binPathW);
+#else
+	if (nm != NULL) fdios_pclose(nm);
+#endif
+}
+
+
+/**
+ * Passes the given batch to the parser stage. The batch is freed if the load
+ * was cancelled.
+ *
+ * @param[in] batch - batch to pass on
+ * @return true on success, false if the load was cancelled
+ */
+bool SymbolLoader::emit(Batch * batch) {
+	if (spsc_pushWait(this->parseQueue, batch) == 0) {
+		delete batch;
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * Passes the given batch to the GUI thread. The batch is freed if the load
+ * was cancelled.
+ *
+ * @param[in] batch - batch to pass on
+ */
+void SymbolLoader::post(Batch * batch) {
+	if ( ! awake(this->handler, batch, &(this->cancelled)) ) delete batch;
+}
+
+
+/**
+ * Checks whether the load was cancelled.
+ *
+ * @return true if cancelled, else false
+ */
+bool SymbolLoader::isCancelled() const {
+	return __atomic_load_n(&(this->cancelled), __ATOMIC_ACQUIRE) != 0;
+}
+
+
+/**
+ * Sets the running nm process which gets killed on cancellation. The process
+ * is killed at once if the load was already cancelled.
+ *
+ * @param[in] handle - nm process handle or NULL once it terminated
+ * @return true on success, false if the load was cancelled
+ */
+bool SymbolLoader::setChild(tFdioPHandle * handle) {
+	thread_mutexLock(this->childMutex);
+	const bool result = ! this->isCancelled();
+	if (handle != NULL && ! result) fdio_pkill(handle);
+	this->child = result ? handle : NULL;
+	thread_mutexUnlock(this->childMutex);
+	return result;
+}
+
+
+} /* namespace gui */
+} /* namespace pcf */
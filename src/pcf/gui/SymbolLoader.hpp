@@ -0,0 +1,128 @@
+/**
+ * @file SymbolLoader.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __PCF_GUI_SYMBOLLOADER_HPP__
+#define __PCF_GUI_SYMBOLLOADER_HPP__
+
+#include <vector>
+#include <FL/Fl.H>
+#include <pcf/gui/SymbolViewer.hpp>
+
+
+extern "C" {
+#include <libpcf/elfsym.h>
+#include <libpcf/fdio.h>
+#include <libpcf/spsc.h>
+#include <libpcf/thread.h>
+}
+
+
+namespace pcf {
+namespace gui {
+
+
+class Demangler;
+class SymbolCache;
+
+
+/**
+ * Loads the symbols of a binary file in the background. Loading is split into
+ * three stages which run in their own thread each and are connected via
+ * single producer single consumer queues:
+ * @li reader - reads the symbol cache, the nm output or the native symbol tables
+ * @li parser - parses the nm output lines and demangles the symbol names
+ * @li store - sorts the symbols, merges them into the list of all symbols and
+ *     passes copies of it periodically to the GUI thread via Fl::awake(); a
+ *     new symbol cache file is written here
+ */
+class SymbolLoader {
+public:
+	/**
+	 * Unit of work passed between the stages and finally to the GUI thread.
+	 * The handler passed to the constructor takes ownership of each batch.
+	 */
+	struct Batch {
+		size_t id; /* load identifier */
+		void * userData; /* user data passed to the constructor */
+		std::vector<char> text; /* raw nm output lines, each null-terminated */
+		SymbolList symbols; /* all symbols loaded so far sorted by size in descending order once passed to the handler */
+		SymbolViewer::MemberList members; /* newly found archive members (automatically freed on destruction) */
+		bool demangled; /* symbol names are already demangled? */
+		bool done; /* last batch of this load? */
+		char * error; /* first nm output line; only set for the last batch (automatically freed on destruction) */
+
+		explicit Batch(const size_t aId = 0, void * aUserData = NULL):
+			id(aId),
+			userData(aUserData),
+			demangled(false),
+			done(false),
+			error(NULL)
+		{}
+
+		~Batch() {
+			for (SymbolViewer::MemberList::iterator it = this->members.begin(); it != this->members.end(); ++it) {
+				if (*it != NULL) free(*it);
+			}
+			if (this->error != NULL) free(this->error);
+		}
+	private:
+		Batch(const Batch &);
+		Batch & operator= (const Batch &);
+	};
+private:
+	size_t id;
+	char * nmPath;
+	char * binPath;
+	bool demangle;
+	bool nativeReader;
+	char * cacheDir;
+	SymbolCache * cache; /* created by the reader, written by the store */
+	Demangler * demangler; /* shared by the parser and the archive readers; NULL if not demangling */
+	Fl_Awake_Handler handler;
+	void * userData;
+	tSpscQueue * parseQueue; /* reader -> parser */
+	tSpscQueue * storeQueue; /* parser -> store */
+	tThread * reader;
+	tThread * parser;
+	tThread * store;
+	volatile int cancelled;
+	tMutex * childMutex; /* guards child */
+	tFdioPHandle * child; /* running nm process */
+	char * firstLine; /* written by the parser before storeQueue gets closed */
+public:
+	explicit SymbolLoader(const size_t aId, const char * aNmPath, const char * aBinPath, const bool aDemangle, const bool aNativeReader, const char * aCacheDir, Fl_Awake_Handler aHandler, void * aUserData);
+	~SymbolLoader();
+
+	bool start();
+	void cancel();
+	size_t getId() const { return this->id; }
+private:
+	SymbolLoader(const SymbolLoader &);
+	SymbolLoader & operator= (const SymbolLoader &);
+
+	static void readerMain(void * param);
+	static void parserMain(void * param);
+	static void storeMain(void * param);
+	static int onElfSymbol(const tElfSymbol * sym, void * param);
+
+	bool readCache();
+	bool readNative();
+	bool readArchive(const void * data, const size_t size);
+	void readNm();
+	void stopStages();
+	bool emit(Batch * batch);
+	void post(Batch * batch);
+	bool isCancelled() const;
+	bool setChild(tFdioPHandle * handle);
+};
+
+
+} /* namespace gui */
+} /* namespace pcf */
+
+
+#endif /* __PCF_GUI_SYMBOLLOADER_HPP__ */
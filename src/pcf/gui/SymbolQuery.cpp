@@ -0,0 +1,501 @@
+/**
+ * @file SymbolQuery.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <pcf/gui/SymbolQuery.hpp>
+
+
+namespace pcf {
+namespace gui {
+namespace {
+
+
+/** Bit mask of all types (A to Z and '?'). */
+static const boost::uint32_t ALL_TYPES = (boost::uint32_t(1) << 27) - 1;
+
+
+/**
+ * Less-than comparer for the evaluation order of terms.
+ *
+ * @param[in] lhs - left hand statement
+ * @param[in] rhs - right hand statement
+ * @return true if less, else false
+ */
+inline bool byCost(const SymbolQuery::Term & lhs, const SymbolQuery::Term & rhs) {
+	return lhs.cost < rhs.cost;
+}
+
+
+/**
+ * Checks whether the given word equals the given keyword.
+ *
+ * @param[in] word - word to check
+ * @param[in] len - word length
+ * @param[in] keyword - null-terminated keyword
+ * @return true if equal, else false
+ */
+inline bool isKeyword(const char * word, const size_t len, const char * keyword) {
+	return strlen(keyword) == len && strncmp(word, keyword, len) == 0;
+}
+
+
+/**
+ * Checks whether the given word starts with the given prefix.
+ *
+ * @param[in] word - word to check
+ * @param[in] len - word length
+ * @param[in] prefix - null-terminated prefix
+ * @return true if the word starts with the prefix, else false
+ */
+inline bool hasPrefix(const char * word, const size_t len, const char * prefix) {
+	const size_t prefixLen = strlen(prefix);
+	return len >= prefixLen && strncmp(word, prefix, prefixLen) == 0;
+}
+
+
+/**
+ * Checks whether the given word is a type, scope, size or case predicate.
+ *
+ * @param[in] word - word to check
+ * @param[in] len - word length
+ * @return true if predicate, else false
+ */
+bool isPredicate(const char * word, const size_t len) {
+	if (hasPrefix(word, len, "type:") || hasPrefix(word, len, "scope:") || hasPrefix(word, len, "case:")) return true;
+	return len > 4 && hasPrefix(word, len, "size") && strchr(":<>=", word[4]) != NULL;
+}
+
+
+/**
+ * Checks whether the given symbol matches the type, scope and size of the
+ * given clause.
+ *
+ * @param[in] clause - query clause
+ * @param[in] type - symbol type
+ * @param[in] size - symbol size
+ * @return true on match, else false
+ */
+inline bool matchesPredicates(const SymbolQuery::Clause & clause, const char type, const long long int size) {
+	if (type >= 'A' && type <= 'Z') {
+		if ((clause.types & (boost::uint32_t(1) << (type - 'A'))) == 0 || ( ! clause.global )) return false;
+	} else if (type >= 'a' && type <= 'z') {
+		if ((clause.types & (boost::uint32_t(1) << (type - 'a'))) == 0 || ( ! clause.local )) return false;
+	} else if (type == '?') {
+		if ((clause.types & (boost::uint32_t(1) << 26)) == 0) return false;
+	}
+	return size >= clause.minSize && size <= clause.maxSize;
+}
+
+
+} /* anonymous namespace */
+
+
+/**
+ * Constructor.
+ */
+SymbolQuery::SymbolQuery() {}
+
+
+/**
+ * Destructor.
+ */
+SymbolQuery::~SymbolQuery() {
+	this->clear();
+}
+
+
+/**
+ * Parses a symbol size in bytes with an optional unit suffix k, M or G
+ * (multiples of 1024). Leading white-spaces are skipped.
+ *
+ * @param[in,out] str - string to parse; set to the first character after the size
+ * @param[out] size - parsed size
+ * @return true on success, false if no valid size was given
+ */
+bool SymbolQuery::parseSize(const char *& str, long long int & size) {
+	static const long long int maxValue = std::numeric_limits<long long int>::max();
+	while (isspace(*str)) str++;
+	if ( ! isdigit(*str) ) return false;
+	long long int value = 0;
+	for (; isdigit(*str); str++) {
+		const int digit = *str - '0';
+		if (value > ((maxValue - digit) / 10)) return false;
+		value = (value * 10) + digit;
+	}
+	long long int unit = 1;
+	switch (*str) {
+	case 'k': case 'K': unit = 1024LL; str++; break;
+	case 'm': case 'M': unit = 1024LL * 1024LL; str++; break;
+	case 'g': case 'G': unit = 1024LL * 1024LL * 1024LL; str++; break;
+	default: break;
+	}
+	if (value > (maxValue / unit)) return false;
+	size = value * unit;
+	return true;
+}
+
+
+/**
+ * Parses a symbol size range in the format "[min][-[max]]". A single size
+ * gives the minimum. Missing limits are unbounded.
+ *
+ * @param[in] str - string to parse
+ * @param[out] minSize - minimal symbol size
+ * @param[out] maxSize - maximal symbol size
+ * @return true on success, false on syntax error (no limits are set in this case)
+ */
+bool SymbolQuery::parseSizeRange(const char * str, long long int & minSize, long long int & maxSize) {
+	minSize = std::numeric_limits<long long int>::min();
+	maxSize = std::numeric_limits<long long int>::max();
+	if (str == NULL) return true;
+	long long int value;
+	while (isspace(*str)) str++;
+	if (*str != '-' && *str != 0) {
+		if ( ! parseSize(str, value) ) return false;
+		minSize = value;
+		while (isspace(*str)) str++;
+	}
+	if (*str == '-') {
+		str++;
+		while (isspace(*str)) str++;
+		if (*str != 0) {
+			if ( ! parseSize(str, value) ) {
+				minSize = std::numeric_limits<long long int>::min();
+				return false;
+			}
+			maxSize = value;
+			while (isspace(*str)) str++;
+		}
+	}
+	if (*str != 0) {
+		minSize = std::numeric_limits<long long int>::min();
+		maxSize = std::numeric_limits<long long int>::max();
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * Parses and compiles the given query. Words which are neither keywords nor
+ * predicates form a name pattern together with the adjacent words.
+ *
+ * @param[in] text - query text
+ * @param[in] ignoreCase - default for ignoring the case of ASCII letters in name patterns
+ * @return true on success, false on syntax error
+ */
+bool SymbolQuery::parse(const char * text, const bool ignoreCase) {
+	this->clear();
+	Clause emptyClause;
+	emptyClause.types = ALL_TYPES;
+	emptyClause.local = true;
+	emptyClause.global = true;
+	emptyClause.minSize = std::numeric_limits<long long int>::min();
+	emptyClause.maxSize = std::numeric_limits<long long int>::max();
+	this->clauses.push_back(emptyClause);
+	if (text == NULL) return true;
+	bool caseIgnored = ignoreCase;
+	bool negated = false;
+	bool clauseEmpty = true;
+	bool expectTerm = false;
+	const char * pattern = NULL; /* start of the pending pattern words */
+	const char * patternEnd = NULL;
+	bool patternNegated = false;
+	bool ok = true;
+	for (const char * pos = text; ok; ) {
+		while (isspace(*pos)) pos++;
+		const char * word = pos;
+		const bool quoted = *pos == '"';
+		if ( quoted ) {
+			const char * close = strchr(pos + 1, '"');
+			if (close == NULL) {
+				ok = false;
+				break;
+			}
+			pos = close + 1;
+		} else {
+			while (*pos != 0 && ( ! isspace(*pos) )) pos++;
+		}
+		const size_t len = size_t(pos - word);
+		const bool isEnd = len == 0;
+		const bool isAnd = ( ! quoted ) && isKeyword(word, len, "AND");
+		const bool isOr = ( ! quoted ) && isKeyword(word, len, "OR");
+		const bool isNot = ( ! quoted ) && isKeyword(word, len, "NOT");
+		const bool isPred = ( ! quoted ) && ( ! isEnd ) && isPredicate(word, len);
+		if (( ! quoted ) && ( ! isEnd ) && ( ! isAnd ) && ( ! isOr ) && ( ! isNot ) && ( ! isPred )) {
+			/* name pattern word */
+			if (pattern == NULL) {
+				pattern = word;
+				patternNegated = negated;
+				negated = false;
+			}
+			patternEnd = pos;
+			continue;
+		}
+		Clause & clause = this->clauses.back();
+		if (pattern != NULL) {
+			ok = this->addPattern(clause, pattern, size_t(patternEnd - pattern), patternNegated, caseIgnored);
+			pattern = NULL;
+			clauseEmpty = false;
+			expectTerm = false;
+			if ( ! ok ) break;
+		}
+		if ( isEnd ) break;
+		if ( quoted ) {
+			ok = len > 2 && this->addPattern(clause, word + 1, len - 2, negated, caseIgnored);
+		} else if ( isNot ) {
+			negated = ! negated;
+			expectTerm = true;
+			continue;
+		} else if (isAnd || isOr) {
+			ok = ( ! negated ) && ( ! clauseEmpty );
+			expectTerm = true;
+			if (isOr && ok) {
+				this->clauses.push_back(emptyClause);
+				clauseEmpty = true;
+			}
+			continue;
+		} else {
+			ok = this->addPredicate(clause, word, len, negated, caseIgnored);
+		}
+		negated = false;
+		clauseEmpty = false;
+		expectTerm = false;
+	}
+	if (( ! ok ) || negated || expectTerm) {
+		this->clear();
+		return false;
+	}
+	/* cheap terms first; negated terms reject few symbols */
+	for (std::vector<Clause>::iterator it = this->clauses.begin(); it != this->clauses.end(); ++it) {
+		std::stable_sort(it->terms.begin(), it->terms.end(), byCost);
+	}
+	return true;
+}
+
+
+/**
+ * Checks whether the query consists of a single clause with at most one name
+ * pattern which is not negated and uses the given case handling. Such a query
+ * is fully described by the clause predicates and getSimplePattern().
+ *
+ * @param[in] ignoreCase - default for ignoring the case of ASCII letters
+ * @return true if simple, else false
+ */
+bool SymbolQuery::isSimple(const bool ignoreCase) const {
+	if (this->clauses.size() != 1) return false;
+	const std::vector<Term> & terms = this->clauses[0].terms;
+	if ( terms.empty() ) return true;
+	if (terms.size() > 1) return false;
+	return terms[0].pattern != NULL && ( ! terms[0].negated ) && terms[0].ignoreCase == ignoreCase;
+}
+
+
+/**
+ * Returns the name pattern of a simple query.
+ *
+ * @return name pattern or an empty string if none
+ * @see isSimple()
+ */
+const char * SymbolQuery::getSimplePattern() const {
+	if (this->clauses.size() != 1 || this->clauses[0].terms.empty() || this->clauses[0].terms[0].pattern == NULL) return "";
+	return this->clauses[0].terms[0].pattern;
+}
+
+
+/**
+ * Checks whether the given symbol matches the query.
+ *
+ * @param[in] list - symbol list
+ * @param[in] i - symbol index
+ * @return true on match, else false
+ */
+bool SymbolQuery::matches(const SymbolList & list, const size_t i) const {
+	const char type = list.getType(i);
+	const long long int size = list.getSize(i);
+	const char * name = NULL;
+	size_t nameLen = 0;
+	for (std::vector<Clause>::const_iterator clause = this->clauses.begin(); clause != this->clauses.end(); ++clause) {
+		if ( ! matchesPredicates(*clause, type, size) ) continue;
+		bool match = true;
+		for (std::vector<Term>::const_iterator term = clause->terms.begin(); match && term != clause->terms.end(); ++term) {
+			bool found;
+			if (term->pattern == NULL) {
+				found = size >= term->minSize && size <= term->maxSize;
+			} else {
+				if (name == NULL) {
+					name = list.getName(i);
+					nameLen = strlen(name);
+				}
+				found = (term->substring != NULL) ? (strsearch_find(term->substring, name, nameLen) != NULL) : (wildcard_match(term->wildcard, name) != 0);
+			}
+			match = found != term->negated;
+		}
+		if ( match ) return true;
+	}
+	return false;
+}
+
+
+/**
+ * Removes all clauses.
+ */
+void SymbolQuery::clear() {
+	for (std::vector<Clause>::iterator clause = this->clauses.begin(); clause != this->clauses.end(); ++clause) {
+		for (std::vector<Term>::iterator term = clause->terms.begin(); term != clause->terms.end(); ++term) {
+			if (term->pattern != NULL) free(term->pattern);
+			if (term->substring != NULL) strsearch_free(term->substring);
+			if (term->wildcard != NULL) wildcard_free(term->wildcard);
+		}
+	}
+	this->clauses.clear();
+}
+
+
+/**
+ * Adds the given type, scope, size or case predicate to the clause. Type,
+ * scope and positive size predicates restrict the clause directly.
+ *
+ * @param[in,out] clause - query clause
+ * @param[in] word - predicate
+ * @param[in] len - predicate length
+ * @param[in] negated - true to negate the predicate
+ * @param[in,out] ignoreCase - case handling of the following name patterns
+ * @return true on success, false on syntax error
+ */
+bool SymbolQuery::addPredicate(Clause & clause, const char * word, const size_t len, const bool negated, bool & ignoreCase) {
+	const std::string str(word, len);
+	const char * value = str.c_str() + str.find_first_of(":<>=");
+	if (hasPrefix(word, len, "type:")) {
+		boost::uint32_t mask = 0;
+		for (value++; *value != 0; value++) {
+			if ( isalpha(*value) ) {
+				mask |= boost::uint32_t(1) << (toupper(*value) - 'A');
+			} else if (*value == '?') {
+				mask |= boost::uint32_t(1) << 26;
+			} else {
+				return false;
+			}
+		}
+		if (mask == 0) return false;
+		clause.types &= negated ? ~mask : mask;
+		return true;
+	}
+	if (hasPrefix(word, len, "scope:")) {
+		value++;
+		bool local;
+		if (strcmp(value, "local") == 0 || strcmp(value, "l") == 0) {
+			local = true;
+		} else if (strcmp(value, "global") == 0 || strcmp(value, "g") == 0) {
+			local = false;
+		} else {
+			return false;
+		}
+		if (local != negated) {
+			clause.global = false;
+		} else {
+			clause.local = false;
+		}
+		return true;
+	}
+	if (hasPrefix(word, len, "case:")) {
+		value++;
+		if (negated) return false;
+		if (strcmp(value, "i") == 0) {
+			ignoreCase = true;
+		} else if (strcmp(value, "s") == 0) {
+			ignoreCase = false;
+		} else {
+			return false;
+		}
+		return true;
+	}
+	/* size */
+	long long int minSize = std::numeric_limits<long long int>::min();
+	long long int maxSize = std::numeric_limits<long long int>::max();
+	if (*value == ':') {
+		if ( ! parseSizeRange(value + 1, minSize, maxSize) ) return false;
+	} else {
+		const char op = *value++;
+		const bool orEqual = *value == '=' && op != '=';
+		if ( orEqual ) value++;
+		long long int size;
+		if (( ! parseSize(value, size) ) || *value != 0) return false;
+		switch (op) {
+		case '>':
+			if ((! orEqual) && size == std::numeric_limits<long long int>::max()) return false;
+			minSize = orEqual ? size : (size + 1);
+			break;
+		case '<':
+			maxSize = orEqual ? size : (size - 1);
+			break;
+		default:
+			minSize = size;
+			maxSize = size;
+			break;
+		}
+	}
+	if ( ! negated ) {
+		clause.minSize = std::max(clause.minSize, minSize);
+		clause.maxSize = std::min(clause.maxSize, maxSize);
+		return true;
+	}
+	Term term;
+	term.pattern = NULL;
+	term.substring = NULL;
+	term.wildcard = NULL;
+	term.ignoreCase = false;
+	term.minSize = minSize;
+	term.maxSize = maxSize;
+	term.negated = true;
+	term.cost = 0;
+	clause.terms.push_back(term);
+	return true;
+}
+
+
+/**
+ * Compiles the given name pattern and adds it to the clause.
+ *
+ * @param[in,out] clause - query clause
+ * @param[in] pattern - name pattern
+ * @param[in] len - pattern length
+ * @param[in] negated - true to negate the pattern
+ * @param[in] ignoreCase - true to ignore the case of ASCII letters
+ * @return true on success, false on error
+ */
+bool SymbolQuery::addPattern(Clause & clause, const char * pattern, const size_t len, const bool negated, const bool ignoreCase) {
+	Term term;
+	term.pattern = static_cast<char *>(malloc(sizeof(char) * (len + 1)));
+	if (term.pattern == NULL) return false;
+	memcpy(term.pattern, pattern, len);
+	term.pattern[len] = 0;
+	const bool isSubstring = strpbrk(term.pattern, "*?#") == NULL;
+	term.substring = isSubstring ? strsearch_create(term.pattern, len, ignoreCase ? 1 : 0) : NULL;
+	term.wildcard = isSubstring ? NULL : wildcard_create(term.pattern, ignoreCase ? 1 : 0);
+	term.ignoreCase = ignoreCase;
+	term.minSize = std::numeric_limits<long long int>::min();
+	term.maxSize = std::numeric_limits<long long int>::max();
+	term.negated = negated;
+	/* substring searches are vectorized; wildcards need more checks */
+	term.cost = (isSubstring ? 1 : 2) + (negated ? 2 : 0);
+	if (term.substring == NULL && term.wildcard == NULL) {
+		free(term.pattern);
+		return false;
+	}
+	clause.terms.push_back(term);
+	return true;
+}
+
+
+} /* namespace gui */
+} /* namespace pcf */
@@ -0,0 +1,95 @@
+/**
+ * @file SymbolQuery.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __PCF_GUI_SYMBOLQUERY_HPP__
+#define __PCF_GUI_SYMBOLQUERY_HPP__
+
+#include <vector>
+#include <pcf/gui/SymbolList.hpp>
+
+
+extern "C" {
+#include <libpcf/strsearch.h>
+#include <libpcf/wildcard.h>
+}
+
+
+namespace pcf {
+namespace gui {
+
+
+/**
+ * Search query over the symbols of a symbol list. A query consists of clauses
+ * combined by OR. Each clause combines its terms by AND. The cheap type,
+ * scope and size predicates of a clause are combined into a type mask and a
+ * size range when parsing. The remaining terms are ordered by their expected
+ * cost with the name patterns last.
+ *
+ * Syntax:
+ * @li pattern - symbol name pattern (adjacent words form a single pattern)
+ * @li "pattern" - symbol name pattern which may contain keywords
+ * @li type:TDB - symbol type is one of the given nm types (regardless of the case)
+ * @li scope:local or scope:global - symbol scope
+ * @li size>N, size>=N, size<N, size<=N, size=N, size:MIN-MAX - symbol size in bytes (k, M, G suffix)
+ * @li case:i or case:s - compare the following patterns ignoring the case or not
+ * @li NOT term - negates the term
+ * @li AND - combines terms (default between adjacent terms)
+ * @li OR - combines clauses (lower precedence than AND)
+ */
+class SymbolQuery {
+public:
+	/** Term checked per symbol. */
+	struct Term {
+		char * pattern; /* name pattern or NULL for a size range */
+		tStrSearch * substring; /* NULL unless the pattern has no wildcards */
+		tWildcard * wildcard; /* NULL unless the pattern has wildcards */
+		bool ignoreCase;
+		long long int minSize;
+		long long int maxSize;
+		bool negated;
+		int cost; /* relative evaluation cost */
+	};
+
+	/** Terms combined by AND. */
+	struct Clause {
+		boost::uint32_t types; /* bit mask of the allowed types (A to Z and '?') */
+		bool local;
+		bool global;
+		long long int minSize;
+		long long int maxSize;
+		std::vector<Term> terms; /* in evaluation order */
+	};
+private:
+	std::vector<Clause> clauses;
+public:
+	explicit SymbolQuery();
+	~SymbolQuery();
+
+	static bool parseSize(const char *& str, long long int & size);
+	static bool parseSizeRange(const char * str, long long int & minSize, long long int & maxSize);
+
+	bool parse(const char * text, const bool ignoreCase);
+	size_t size() const { return this->clauses.size(); }
+	const Clause & getClause(const size_t n) const { return this->clauses[n]; }
+	bool isSimple(const bool ignoreCase) const;
+	const char * getSimplePattern() const;
+	bool matches(const SymbolList & list, const size_t i) const;
+	void clear();
+private:
+	SymbolQuery(const SymbolQuery &);
+	SymbolQuery & operator= (const SymbolQuery &);
+
+	bool addPredicate(Clause & clause, const char * word, const size_t len, const bool negated, bool & ignoreCase);
+	bool addPattern(Clause & clause, const char * pattern, const size_t len, const bool negated, const bool ignoreCase);
+};
+
+
+} /* namespace gui */
+} /* namespace pcf */
+
+
+#endif /* __PCF_GUI_SYMBOLQUERY_HPP__ */
@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2017-2023 Daniel Starke
  * @date 2017-12-01
- * @version 2023-04-16
+ * @version 2026-10-16
  * @remarks nm -S --size-sort -f bsd -t d <file>
  */
 #include <algorithm>
@@ -11,7 +11,9 @@
 #include <cstdlib>
 #include <cstdio>
 #include <cstring>
-#include <cxxabi.h>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <FL/filename.H>
 #include <FL/fl_ask.H>
 #include <FL/fl_draw.H>
@@ -20,17 +22,23 @@
 #include <FL/Fl_Scroll.H>
 #include <FL/Fl_Text_Display.H>
 #include <FL/Fl_Tile.H>
+#include <pcf/gui/FileWatcher.hpp>
+#include <pcf/gui/LazyDemangler.hpp>
+#include <pcf/gui/SymbolCache.hpp>
+#include <pcf/gui/SymbolLoader.hpp>
+#include <pcf/gui/SymbolQuery.hpp>
 #include <pcf/gui/SymbolViewer.hpp>
+#include <pcf/gui/TrigramIndex.hpp>
+#include <pcf/gui/TypeBuckets.hpp>
+#include <pcf/gui/WorkerPool.hpp>
 #include <pcf/Utility.hpp>
 #include <license.hpp>
 
 
 extern "C" {
 #include <errno.h>
-#include <libpcf/fdios.h>
-#ifdef PCF_IS_WIN
-#include <libpcf/fdious.h>
-#endif
+#include <libpcf/thread.h>
+#include <libpcf/wildcard.h>
 }
 
 
@@ -304,121 +312,94 @@ inline int roundToInt(const float val) {
 
 
 /**
- * Returns 1 if text matches pattern, else 0.
- * Valid characters for the matching string are:
- * @li * matches any character 0 to unlimited times
- * @li ? matches any character exactly once
- * @li # matches any digit exactly once
- * Any other character will be expected to be the same as in text to match.
+ * Returns true if the given pattern can only match demangled names. Mangled
+ * names consist of letters, digits, '_', '$' and '.' only.
  *
- * @param[in] text - text string
- * @param[in] pattern - wildcard matching string
- * @return 1 on match, else 0
+ * @param[in] pattern - search pattern
+ * @return true if demangled names are needed, else false
  */
-int matchPattern(const char * text, const char * pattern) {
-	const char * curText; /* current text */
-	const char * curPat; /* current pattern */
-	const char * laText; /* look ahead text */
-	const char * laPat; /* look ahead pattern */
-	const char * sPat; /* saved pattern */
-	if (text == NULL || pattern == NULL) return 0;
-	curText = text;
-	curPat = pattern;
-	do {
-		switch (*curPat) {
-		case '*':
-			laText = curText;
-			laPat = curPat + 1;
-			if (*laPat == 0) return 1;
-			if (*laText == 0) {
-				curPat = laPat;
-				continue;
-			}
-			sPat = laPat;
-			while (*sPat == '*') {
-				curPat = sPat;
-				sPat++;
-			}
-			if (*sPat == *curText || *sPat == '?' || (*sPat == '#' && isdigit(*curText))) {
-				laPat = sPat;
-				while (*laPat != '*' && *laPat != 0) {
-					if (*laText == *laPat || *laPat == '?' || (*laPat == '#' && isdigit(*laText))) {
-						laText++;
-						laPat++;
-					} else {
-						curText++;
-						break;
-					}
-					if (*laText == 0) {
-						while (*laPat == '*') {
-							laPat++;
-						}
-						if (*laPat == 0) {
-							return 1;
-						} else {
-							curText++;
-							break;
-						}
-					}
-				}
-				if (*laPat == '*') {
-					curText = laText;
-					sPat = laPat;
-				} else {
-					if (*laText == *laPat && *laPat == 0) {
-						/* this point will never be reached (see previous return) */
-						return 1;
-					} else if (*laText == 0) {
-						continue;
-					} else if (*laPat == 0) {
-						curText++;
-						sPat = curPat;
-					} else {
-						sPat = curPat;
-					}
-				}
-				curPat = sPat;
-			} else {
-				curText++;
-			}
-			break;
-		case '?':
-			if (*curText != 0) {
-				curText++;
-				curPat++;
-				if (*curText != 0 && *curPat == 0) {
-					return 0;
-				}
-			} else {
-				return 0;
-			}
-			break;
-		case '#':
-			if ( isdigit(*curText) ) {
-				curText++;
-				curPat++;
-				if (*curText != 0 && *curPat == 0) {
-					return 0;
-				}
-			} else {
-				return 0;
-			}
-			break;
-		default:
-			if (*curText == *curPat) {
-				curText++;
-				curPat++;
-			} else {
-				return 0;
-			}
-			break;
+bool needsDemangledNames(const char * pattern) {
+	if (pattern == NULL) return false;
+	for (; *pattern != 0; pattern++) {
+		const char c = *pattern;
+		if (isalnum(c) || strchr("_$.*?#", c) != NULL) continue;
+		return true;
+	}
+	return false;
+}
+
+
+/**
+ * Returns true if any name pattern of the given query can only match demangled
+ * names. An invalid query is searched as plain pattern.
+ *
+ * @param[in] text - search query
+ * @param[in] ignoreCase - default case sensitivity of the query
+ * @return true if demangled names are needed, else false
+ */
+bool queryNeedsDemangledNames(const char * text, const bool ignoreCase) {
+	SymbolQuery plan;
+	if ( ! plan.parse(text, ignoreCase) ) return needsDemangledNames(text);
+	for (size_t n = 0; n < plan.size(); n++) {
+		const std::vector<SymbolQuery::Term> & terms = plan.getClause(n).terms;
+		for (std::vector<SymbolQuery::Term>::const_iterator it = terms.begin(); it != terms.end(); ++it) {
+			if ( needsDemangledNames(it->pattern) ) return true;
 		}
-	} while (*curPat != 0);
-	if (*curText != 0) return 0;
-	return 1;
+	}
+	return false;
+}
+
+
+/**
+ * Returns true if the index of the given symbol row is less than the given
+ * symbol index.
+ *
+ * @param[in] lhs - symbol row
+ * @param[in] rhs - symbol index
+ * @return true if less, else false
+ */
+inline bool byRowIndex(const SymbolViewer::SymbolRow & lhs, const boost::uint32_t rhs) {
+	return lhs.index < rhs;
+}
+
+
+/**
+ * Returns true if every symbol matching the given filter also matches the
+ * previous filter. The result of the previous filter can be refined in this
+ * case instead of scanning all symbols again.
+ *
+ * @param[in] pattern - search pattern
+ * @param[in] types - bit mask of the enabled type filters
+ * @param[in] minSize - minimal symbol size
+ * @param[in] maxSize - maximal symbol size
+ * @param[in] prev - previous filter result
+ * @return true if refined, else false
+ */
+bool refinesFilter(const char * pattern, const boost::uint32_t types, const long long int minSize, const long long int maxSize, const SymbolViewer::FilterResult & prev) {
+	const char * prevPattern = prev.pattern;
+	if ((types & ~prev.types) != 0) return false;
+	if (minSize < prev.minSize || maxSize > prev.maxSize) return false;
+	if (*prevPattern == 0 || strcmp(pattern, prevPattern) == 0) return true;
+	/* a name containing the new substring also contains each part of it */
+	if (xstrpbrk(pattern, "*?#") != NULL || xstrpbrk(prevPattern, "*?#") != NULL) return false;
+	return strstr(pattern, prevPattern) != NULL;
 }
 
 
+/** Maximum number of demangled names kept for display if demangling on demand. */
+static const size_t LAZY_DEMANGLE_CACHE_SIZE = 4096;
+/** Maximum number of previous filter results kept for refinement. */
+static const size_t FILTER_STACK_SIZE = 8;
+/** Maximum number of complete search results kept for reuse. */
+static const size_t RESULT_CACHE_SIZE = 16;
+/** Maximum number of symbol rows of all search results kept for reuse. */
+static const size_t RESULT_CACHE_ROWS = 0x1000000;
+/** Minimum number of symbols to build a name index for. Smaller lists are searched fast enough. */
+static const size_t INDEX_MIN_SYMBOLS = 0x40000;
+/** Number of symbols filtered by a thread at once. */
+static const size_t FILTER_CHUNK_SIZE = 0x4000;
+
+
 /** Most recently updated ListView widget. */
 static Fl_Widget * lastListView = NULL;
 
@@ -592,8 +573,8 @@ protected:
 };
 
 
-typedef ListView<SymbolViewer::Statistics, 3, SymbolViewer::Statistics> StatsListView;
-typedef ListView<SymbolViewer::Symbol, 3, SymbolViewer::Statistics> SymsListView;
+typedef ListView<SymbolViewer::Statistics, 3, SymbolViewer::ViewContext> StatsListView;
+typedef ListView<SymbolViewer::SymbolRow, 4, SymbolViewer::ViewContext> SymsListView;
 
 
 /**
@@ -615,9 +596,333 @@ public:
 };
 
 
+/**
+ * Filter criteria and results shared by all filter threads. The symbols are
+ * processed in chunks. Each chunk keeps its matching rows to concatenate them
+ * in symbol order afterwards.
+ */
+struct FilterContext {
+	const SymbolList & list;
+	const boost::uint32_t * candidates; /* symbols to filter or NULL */
+	const SymbolViewer::SymbolRow * rows; /* symbols to filter if no candidates or NULL for all */
+	size_t first; /* index of the first symbol to filter if neither candidates nor rows are given */
+	size_t count; /* number of symbols to filter */
+	const bool * filter; /* enabled type filters */
+	bool local;
+	bool global;
+	const tStrSearch * substring; /* NULL if no substring search */
+	const tWildcard * wildcard; /* NULL if no wildcard search */
+	const std::vector<boost::uint32_t> * matchingNames; /* ascending name offsets of all matching names or NULL */
+	const SymbolQuery * query; /* NULL if no query with several terms */
+	const volatile int * cancelled; /* stops filtering once set to non-zero */
+	std::vector< std::vector<SymbolViewer::SymbolRow> > chunks; /* matching rows per chunk */
+	size_t end; /* chunks up to this one are processed */
+	volatile size_t next; /* next chunk to process */
+
+	explicit FilterContext(const SymbolList & aList):
+		list(aList),
+		candidates(NULL),
+		rows(NULL),
+		first(0),
+		count(0),
+		filter(NULL),
+		local(false),
+		global(false),
+		substring(NULL),
+		wildcard(NULL),
+		matchingNames(NULL),
+		query(NULL),
+		cancelled(NULL),
+		end(0),
+		next(0)
+	{}
+private:
+	FilterContext(const FilterContext &);
+	FilterContext & operator= (const FilterContext &);
+};
+
+
+/**
+ * Statistics of the symbols matched by a single filter thread.
+ */
+struct FilterWorker {
+	FilterContext * ctx;
+	SymbolViewer::Statistics total;
+	SymbolViewer::Statistics types[27];
+	std::vector<SymbolViewer::Statistics> members;
+};
+
+
+/**
+ * Filter thread function which processes chunks of symbols until all up to
+ * FilterContext::end have been processed.
+ *
+ * @param[in,out] param - pointer to FilterWorker
+ */
+void filterWorker(void * param) {
+	FilterWorker * self = static_cast<FilterWorker *>(param);
+	FilterContext & ctx = *(self->ctx);
+	const SymbolList & list = ctx.list;
+	const std::vector<char> & types = list.getTypes();
+	const std::vector<long long int> & sizes = list.getSizes();
+	const std::vector<int> & members = list.getMembers();
+	const SymbolList::OffsetList & nameOffsets = list.getNameOffsets();
+	for (;;) {
+		const size_t chunk = thread_fetchAdd(&(ctx.next), 1);
+		if (chunk >= ctx.end) break;
+		if (ctx.cancelled != NULL && __atomic_load_n(ctx.cancelled, __ATOMIC_ACQUIRE) != 0) break;
+		std::vector<SymbolViewer::SymbolRow> & rows = ctx.chunks[chunk];
+		const size_t first = chunk * FILTER_CHUNK_SIZE;
+		const size_t last = std::min(first + FILTER_CHUNK_SIZE, ctx.count);
+		for (size_t k = first; k < last; k++) {
+			const size_t i = (ctx.candidates != NULL) ? size_t(ctx.candidates[k]) : ((ctx.rows != NULL) ? size_t(ctx.rows[k].index) : (ctx.first + k));
+			/* filter by type first as it only needs the type column */
+			const char type = types[i];
+			SymbolViewer::Statistics * aStat = NULL;
+			if ( isalpha(type) ) {
+				if ( ! ctx.filter[int(toupper(type) - 'A')] ) continue;
+				if (islower(type) && !ctx.local) continue;
+				if (isupper(type) && !ctx.global) continue;
+				aStat = self->types + int(toupper(type) - 'A');
+			} else if (type == '?') {
+				if ( ! ctx.filter[26] ) continue;
+				aStat = self->types + 26;
+			}
+			/* skip if pattern does not match (or substring not included if no real pattern given) */
+			if (ctx.query != NULL) {
+				if ( ! ctx.query->matches(list, i) ) continue;
+			} else if (ctx.matchingNames != NULL) {
+				if ( ! std::binary_search(ctx.matchingNames->begin(), ctx.matchingNames->end(), nameOffsets[i]) ) continue;
+			} else if (ctx.substring != NULL) {
+				const char * name = list.getName(i);
+				if (strsearch_find(ctx.substring, name, strlen(name)) == NULL) continue;
+			} else if (ctx.wildcard != NULL) {
+				if ( ! wildcard_match(ctx.wildcard, list.getName(i)) ) continue;
+			}
+			const long long int size = sizes[i];
+			const int member = members[i];
+			rows.push_back(SymbolViewer::SymbolRow(boost::uint32_t(i)));
+			if (size > 0) {
+				self->total.size += size;
+			}
+			self->total.symbols++;
+			if (aStat != NULL) {
+				aStat->size += size;
+				aStat->symbols++;
+			}
+			if (member >= 0 && size_t(member) < self->members.size()) {
+				self->members[size_t(member)].size += size;
+				self->members[size_t(member)].symbols++;
+			}
+		}
+	}
+}
+
+
+/**
+ * Adds the totals of the symbols of the given bucket within the given symbol
+ * index range to the statistics. The precomputed bucket totals are used if
+ * the range covers all symbols.
+ *
+ * @param[in] list - symbol list
+ * @param[in] bucket - type bucket
+ * @param[in] first - first symbol index
+ * @param[in] last - symbol index after the last one
+ * @param[in,out] total - total statistics
+ * @param[in,out] typeStat - type statistics or NULL
+ * @param[in,out] memberStats - archive member statistics
+ */
+void addBucketTotals(const SymbolList & list, const TypeBuckets::Bucket & bucket, const size_t first, const size_t last, SymbolViewer::Statistics & total, SymbolViewer::Statistics * typeStat, std::vector<SymbolViewer::Statistics> & memberStats) {
+	if (first == 0 && last >= list.size()) {
+		total.size += bucket.positiveSize;
+		total.symbols += bucket.rows.size();
+		if (typeStat != NULL) {
+			typeStat->size += bucket.size;
+			typeStat->symbols += bucket.rows.size();
+		}
+		for (std::vector<TypeBuckets::MemberTotals>::const_iterator it = bucket.members.begin(); it != bucket.members.end(); ++it) {
+			if (size_t(it->member) >= memberStats.size()) continue;
+			memberStats[size_t(it->member)].size += it->size;
+			memberStats[size_t(it->member)].symbols += it->symbols;
+		}
+		return;
+	}
+	const std::vector<long long int> & sizes = list.getSizes();
+	const std::vector<int> & members = list.getMembers();
+	const std::vector<boost::uint32_t>::const_iterator from = std::lower_bound(bucket.rows.begin(), bucket.rows.end(), boost::uint32_t(first));
+	const std::vector<boost::uint32_t>::const_iterator to = std::lower_bound(from, bucket.rows.end(), boost::uint32_t(last));
+	for (std::vector<boost::uint32_t>::const_iterator it = from; it != to; ++it) {
+		const long long int size = sizes[*it];
+		const int member = members[*it];
+		if (size > 0) total.size += size;
+		total.symbols++;
+		if (typeStat != NULL) {
+			typeStat->size += size;
+			typeStat->symbols++;
+		}
+		if (member >= 0 && size_t(member) < memberStats.size()) {
+			memberStats[size_t(member)].size += size;
+			memberStats[size_t(member)].symbols++;
+		}
+	}
+}
+
+
+/**
+ * Returns the symbol index range within the given size range. The symbols
+ * form a slice as the list is sorted by size in descending order.
+ *
+ * @param[in] sizes - symbol sizes in descending order
+ * @param[in] minSize - minimal symbol size
+ * @param[in] maxSize - maximal symbol size
+ * @param[out] first - first symbol index
+ * @param[out] last - symbol index after the last one
+ */
+void sizeSlice(const std::vector<long long int> & sizes, const long long int minSize, const long long int maxSize, size_t & first, size_t & last) {
+	first = size_t(std::lower_bound(sizes.begin(), sizes.end(), maxSize, std::greater<long long int>()) - sizes.begin());
+	last = std::max(first, size_t(std::upper_bound(sizes.begin(), sizes.end(), minSize, std::greater<long long int>()) - sizes.begin()));
+}
+
+
+/**
+ * Removes the symbol indices outside the given range.
+ *
+ * @param[in,out] rows - ascending symbol indices
+ * @param[in] first - first symbol index
+ * @param[in] last - symbol index after the last one
+ */
+void trimToSlice(std::vector<boost::uint32_t> & rows, const size_t first, const size_t last) {
+	rows.erase(std::lower_bound(rows.begin(), rows.end(), boost::uint32_t(last)), rows.end());
+	rows.erase(rows.begin(), std::lower_bound(rows.begin(), rows.end(), boost::uint32_t(first)));
+}
+
+
+/**
+ * Selects the type buckets of the symbols which pass the given type filter
+ * and the type restriction of a query clause.
+ *
+ * @param[in] filter - enabled type filters (27 elements)
+ * @param[in] local - true to select local symbols
+ * @param[in] global - true to select global symbols
+ * @param[in] clause - query clause or NULL
+ * @param[out] selected - selected buckets (TypeBuckets::COUNT elements)
+ * @return true if the selection excludes any type, else false
+ */
+bool selectBuckets(const bool * filter, const bool local, const bool global, const SymbolQuery::Clause * clause, bool * selected) {
+	bool restricted = false;
+	for (size_t n = 0; n < 27; n++) {
+		const bool allowed = filter[n] && (clause == NULL || (clause->types & (boost::uint32_t(1) << n)) != 0);
+		if (n < 26) {
+			selected[TypeBuckets::GLOBAL + n] = allowed && global && (clause == NULL || clause->global);
+			selected[TypeBuckets::LOCAL + n] = allowed && local && (clause == NULL || clause->local);
+			restricted = restricted || ( ! selected[TypeBuckets::GLOBAL + n] ) || ( ! selected[TypeBuckets::LOCAL + n] );
+		} else {
+			selected[TypeBuckets::UNKNOWN] = allowed;
+			restricted = restricted || ( ! allowed );
+		}
+	}
+	selected[TypeBuckets::OTHER] = true;
+	return restricted;
+}
+
+
+/**
+ * Runs the given filter workers in parallel until all chunks up to
+ * FilterContext::end have been processed. The calling thread takes part.
+ *
+ * @param[in,out] pool - threads to run the workers
+ * @param[in,out] workers - filter workers of the same context
+ */
+void runWorkers(WorkerPool & pool, std::vector<FilterWorker> & workers) {
+	std::vector<void *> params(workers.size());
+	for (size_t n = 0; n < workers.size(); n++) params[n] = &(workers[n]);
+	pool.run(filterWorker, &(params[0]), params.size());
+}
+
+
 } /* anonymous namespace */
 
 
+/**
+ * Search which may run in the background. The inputs are taken within the GUI
+ * thread and the results are applied there once done.
+ */
+struct SymbolViewer::Query {
+	SymbolViewer * viewer;
+	size_t generation; /* SymbolViewer::queryGeneration at start */
+	tThread * thread; /* NULL if run within the GUI thread */
+	bool background; /* true if run by thread */
+	volatile int cancelled;
+	volatile int finished;
+	volatile int rowsReady; /* topRows are complete */
+	bool rowsShown; /* topRows have been shown */
+	/* inputs */
+	char * pattern;
+	boost::uint32_t types; /* bit mask of the enabled type filters */
+	bool filter[27];
+	bool local;
+	bool global;
+	long long int minSize;
+	long long int maxSize;
+	const FilterResult * base; /* previous result to refine or NULL */
+	bool hasPattern; /* false if the base matches the pattern already */
+	bool sameFilter; /* true if the base has the same filter */
+	const TrigramIndex * index; /* NULL if not ready */
+	const TypeBuckets * buckets; /* NULL if not ready or a pattern was given */
+	SymbolQuery * plan; /* NULL unless the query has several name patterns or OR/NOT terms */
+	size_t limit; /* maximum number of shown symbols or 0 for all */
+	size_t symbolGeneration; /* SymbolViewer::symbolGeneration at start */
+	bool cached; /* result was taken from the result cache */
+	/* results */
+	std::vector<SymbolRow> rows;
+	std::vector<SymbolRow> topRows; /* first limit rows before the statistics are complete */
+	Statistics total;
+	Statistics typeStats[27];
+	std::vector<Statistics> memberStats;
+	
+	explicit Query(SymbolViewer * aViewer, const size_t aGeneration):
+		viewer(aViewer),
+		generation(aGeneration),
+		thread(NULL),
+		background(false),
+		cancelled(0),
+		finished(0),
+		rowsReady(0),
+		rowsShown(false),
+		pattern(NULL),
+		types(0),
+		local(false),
+		global(false),
+		minSize(std::numeric_limits<long long int>::min()),
+		maxSize(std::numeric_limits<long long int>::max()),
+		base(NULL),
+		hasPattern(false),
+		sameFilter(false),
+		index(NULL),
+		buckets(NULL),
+		plan(NULL),
+		limit(0),
+		symbolGeneration(0),
+		cached(false),
+		total('_')
+	{
+		for (size_t n = 0; n < 26; n++) {
+			this->filter[n] = false;
+			this->typeStats[n] = Statistics(char('A' + n));
+		}
+		this->filter[26] = false;
+	}
+	
+	~Query() {
+		if (this->pattern != NULL) free(this->pattern);
+		delete this->plan;
+	}
+private:
+	Query(const Query &);
+	Query & operator= (const Query &);
+};
+
+
 /**
  * Returns the string representation of the requested field index.
  * 
@@ -625,11 +930,13 @@ public:
  * @param[in] userData - reference values
  * @return string
  */
-const char * SymbolViewer::Statistics::operator() (const size_t i, const Statistics & userData) const {
+const char * SymbolViewer::Statistics::operator() (const size_t i, const ViewContext & userData) const {
 	static char buffer[32];
 	switch (i) {
 	case 0:
-		if (isalpha(this->type)) {
+		if (this->member >= 0) {
+			return userData.member(this->member);
+		} else if (isalpha(this->type)) {
 			return typeStr[toupper(this->type) - 'A'];
 		} else if (this->type == '_') {
 			return "total";
@@ -639,7 +946,7 @@ const char * SymbolViewer::Statistics::operator() (const size_t i, const Statist
 		break;
 	case 1:
 		{
-			const float percent = 100.0f * float(this->size) / float(userData.size);
+			const float percent = 100.0f * float(this->size) / float(userData.total.size);
 			snprintf(buffer, sizeof(buffer), "%lld (%i%%)", this->size, roundToInt(percent));
 		}
 		buffer[31] = 0;
@@ -647,7 +954,7 @@ const char * SymbolViewer::Statistics::operator() (const size_t i, const Statist
 		break;
 	case 2:
 		{
-			const float percent = 100.0f * float(this->symbols) / float(userData.symbols);
+			const float percent = 100.0f * float(this->symbols) / float(userData.total.symbols);
 			snprintf(buffer, sizeof(buffer), "%llu (%i%%)", static_cast<unsigned long long>(this->symbols), roundToInt(percent));
 		}
 		buffer[31] = 0;
@@ -667,28 +974,34 @@ const char * SymbolViewer::Statistics::operator() (const size_t i, const Statist
  * @param[in] userData - reference values
  * @return string
  */
-const char * SymbolViewer::Symbol::operator() (const size_t i, const Statistics & userData) const {
+const char * SymbolViewer::SymbolRow::operator() (const size_t i, const ViewContext & userData) const {
 	static char buffer[32];
+	const SymbolList & list = *(userData.symbols);
+	const size_t n = size_t(this->index);
 	switch (i) {
 	case 0:
-		if (isalpha(this->type)) {
-			return typeStr[toupper(this->type) - 'A'];
-		} else if (this->type == '_') {
-			return "total";
+		if (isalpha(list.getType(n))) {
+			return typeStr[toupper(list.getType(n)) - 'A'];
 		} else {
 			return "unknown";
 		}
 		break;
 	case 1:
-		{
-			const float percent = 100.0f * float(this->size) / float(userData.size);
-			snprintf(buffer, sizeof(buffer), "%lld (%i%%)", this->size, roundToInt(percent));
+		if (userData.total.symbols <= 0) {
+			/* total not known yet */
+			snprintf(buffer, sizeof(buffer), "%lld", list.getSize(n));
+		} else {
+			const float percent = 100.0f * float(list.getSize(n)) / float(userData.total.size);
+			snprintf(buffer, sizeof(buffer), "%lld (%i%%)", list.getSize(n), roundToInt(percent));
 		}
 		buffer[31] = 0;
 		return buffer;
 		break;
 	case 2:
-		return this->name;
+		return userData.member(list.getMember(n));
+		break;
+	case 3:
+		return (userData.demangler != NULL) ? userData.demangler->get(list.getName(n)) : list.getName(n);
 		break;
 	default:
 		return NULL;
@@ -711,25 +1024,44 @@ SymbolViewer::SymbolViewer(const int W, const int H, const char * L):
 	browseNm(NULL),
 	binPath(NULL),
 	browseBin(NULL),
+	cancelLoad(NULL),
 	pattern(NULL),
+	sizeRange(NULL),
 	stats(NULL),
 	symbols(NULL),
 	chooseNm(NULL),
 	chooseBin(NULL),
 	licenseWin(NULL),
 	typeFilter(NULL),
+	loader(NULL),
+	watcher(NULL),
+	lazyDemangler(NULL),
+	nameIndex(new TrigramIndex()),
+	typeBuckets(new TypeBuckets()),
+	filterPool(new WorkerPool()),
+	query(NULL),
+	queryGeneration(0),
+	searchDelay(0.0),
+	topSymbols(0),
+	symbolGeneration(0),
+	loadId(0),
+	reloading(false),
 #ifdef PCF_IS_WIN
 	currentNm(strdup("nm.exe")),
 #else
 	currentNm(strdup("nm")),
 #endif
 	currentBin(NULL),
-	demangleSymbols(true)
+	cacheDir(NULL),
+	demangleSymbols(true),
+	nativeReader(true),
+	ignoreCase(false)
 {
 	const int spaceH  = adjDpiH(10); /* horizontal spacing */
 	const int spaceV  = adjDpiV(10); /* vertical spacing */
 	const int labelH  = adjDpiH(50);
 	const int browseH = adjDpiH(30);
+	const int sizeH   = adjDpiH(100);
 	const int inputV  = adjDpiV(20);
 	int y = spaceH;
 	Fl_Group * g; /* group widget for resize adjustments */
@@ -740,6 +1072,30 @@ SymbolViewer::SymbolViewer(const int W, const int H, const char * L):
 	const char * dsFromEnv = fl_getenv("DISABLE_DEMANGLING");
 	if (dsFromEnv != NULL && dsFromEnv[0] == '1' && dsFromEnv[1] == 0) demangleSymbols = false;
 	
+	const char * ldFromEnv = fl_getenv("LAZY_DEMANGLING");
+	if (demangleSymbols && ldFromEnv != NULL && ldFromEnv[0] == '1' && ldFromEnv[1] == 0) lazyDemangler = new LazyDemangler(LAZY_DEMANGLE_CACHE_SIZE, SymbolViewer::onDemangled, this);
+	
+	const char * dnFromEnv = fl_getenv("DISABLE_NATIVE_READER");
+	if (dnFromEnv != NULL && dnFromEnv[0] == '1' && dnFromEnv[1] == 0) nativeReader = false;
+	
+	const char * sdFromEnv = fl_getenv("SEARCH_DELAY");
+	if (sdFromEnv != NULL && *sdFromEnv != 0) searchDelay = double(strtoul(sdFromEnv, NULL, 10)) / 1000.0;
+	
+	const char * tsFromEnv = fl_getenv("TOP_SYMBOLS");
+	if (tsFromEnv != NULL && *tsFromEnv != 0) topSymbols = size_t(strtoul(tsFromEnv, NULL, 10));
+	
+	const char * ciFromEnv = fl_getenv("CASE_INSENSITIVE_SEARCH");
+	if (ciFromEnv != NULL && ciFromEnv[0] == '1' && ciFromEnv[1] == 0) ignoreCase = true;
+	
+	const char * dcFromEnv = fl_getenv("DISABLE_SYMBOL_CACHE");
+	if (dcFromEnv == NULL || dcFromEnv[0] != '1' || dcFromEnv[1] != 0) {
+		const char * cdFromEnv = fl_getenv("SYMBOL_CACHE_DIR");
+		cacheDir = (cdFromEnv != NULL && *cdFromEnv != 0) ? strdup(cdFromEnv) : SymbolCache::getDefaultDirectory();
+	}
+	
+	const char * daFromEnv = fl_getenv("DISABLE_AUTO_RELOAD");
+	if (daFromEnv == NULL || daFromEnv[0] != '1' || daFromEnv[1] != 0) watcher = new FileWatcher(SymbolViewer::onFileChange, this);
+	
 	if (L != NULL) this->baseLabel = strdup(L);
 	
 	g = new DropForward<Fl_Group>(spaceH, y, W - (2 * spaceH), inputV);
@@ -759,14 +1115,22 @@ SymbolViewer::SymbolViewer(const int W, const int H, const char * L):
 	binPath->when(FL_WHEN_CHANGED);
 	browseBin = new DropForward<Fl_Button>(W - spaceH - browseH, y, browseH, inputV, "...");
 	browseBin->callback(PCF_GUI_CALLBACK(onBrowseBin), this);
+	cancelLoad = new DropForward<Fl_Button>(W - spaceH - browseH, y, browseH, inputV, "@-2square");
+	cancelLoad->tooltip("Cancel loading (Esc)");
+	cancelLoad->labelcolor(fl_lighter(FL_RED));
+	cancelLoad->callback(PCF_GUI_CALLBACK(onCancelLoad), this);
+	cancelLoad->hide();
 	g->resizable(binPath);
 	g->end();
 	y += spaceH + inputV;
 	
 	g = new DropForward<Fl_Group>(spaceH, y, W - (2 * spaceH), inputV);
-	pattern = new TriggerHappyInput(spaceH + labelH, y, W - (2 * spaceH) - browseH - labelH - 2, inputV, "pattern");
-	pattern->tooltip("* matches any character 0 to unlimited times\n? matches any character exactly once\n# matches any digit exactly once");
+	pattern = new TriggerHappyInput(spaceH + labelH, y, W - (2 * spaceH) - browseH - (2 * labelH) - sizeH - 4, inputV, "pattern");
+	pattern->tooltip("* matches any character 0 to unlimited times\n? matches any character exactly once\n# matches any digit exactly once\nAND, OR and NOT combine terms (e.g. foo OR bar)\ntype:TDB, scope:local, scope:global, size>4k and size:1k-1M filter symbols\ncase:i or case:s set the case sensitivity of the following patterns\n\"quoted\" patterns may contain these keywords");
 	pattern->callback(PCF_GUI_CALLBACK(onChangePattern), this);
+	sizeRange = new TriggerHappyInput(W - spaceH - browseH - sizeH - 2, y, sizeH, inputV, "size");
+	sizeRange->tooltip("symbol size range in bytes as min-max (e.g. 4k- or 100-1M)\na single size gives the minimum\nk, M and G are multiples of 1024");
+	sizeRange->callback(PCF_GUI_CALLBACK(onChangePattern), this);
 	info = new DropForward<Fl_Button>(W - spaceH - browseH, y, browseH, inputV, "@#menu");
 	info->labelcolor(fl_lighter(FL_RED));
 	info->callback(PCF_GUI_CALLBACK(onInformation), this);
@@ -784,12 +1148,20 @@ SymbolViewer::SymbolViewer(const int W, const int H, const char * L):
 	static_cast<StatsListView *>(stats)->headerData[1] = "Size";
 	static_cast<StatsListView *>(stats)->headerData[2] = "Symbols";
 	static_cast<StatsListView *>(stats)->callback(PCF_GUI_CALLBACK(onTableEvent), this);
+	static_cast<StatsListView *>(stats)->userData.members = &memberList;
 	
 	symbols = new SymsListView(tile->x(), tile->y() + (tile->h() / 2), tile->w(), tile->h() / 2);
 	static_cast<SymsListView *>(symbols)->headerData[0] = "Type";
 	static_cast<SymsListView *>(symbols)->headerData[1] = "Size";
-	static_cast<SymsListView *>(symbols)->headerData[2] = "Symbol";
+	static_cast<SymsListView *>(symbols)->headerData[2] = "Member";
+	static_cast<SymsListView *>(symbols)->headerData[3] = "Symbol";
 	static_cast<SymsListView *>(symbols)->callback(PCF_GUI_CALLBACK(onTableEvent), this);
+	static_cast<SymsListView *>(symbols)->userData.members = &memberList;
+	static_cast<SymsListView *>(symbols)->userData.symbols = &symbolList;
+	static_cast<SymsListView *>(symbols)->userData.demangler = lazyDemangler;
+	/* the member column is only shown for archives */
+	symbols->col_width(3, symbols->col_width(3) + symbols->col_width(2));
+	symbols->col_width(2, 0);
 	
 	tile->end();
 	
@@ -831,12 +1203,22 @@ SymbolViewer::SymbolViewer(const int W, const int H, const char * L):
  * Destructor.
  */
 SymbolViewer::~SymbolViewer() {
+	Fl::remove_timeout(SymbolViewer::onSearchDelay, this);
+	this->cancelQuery();
+	delete this->loader;
+	delete this->watcher;
+	delete this->lazyDemangler;
+	delete this->nameIndex;
+	delete this->typeBuckets;
+	delete this->filterPool;
 	if (this->baseLabel != NULL) free(this->baseLabel);
 	delete this->nmPath;
 	delete this->browseNm;
 	delete this->binPath;
 	delete this->browseBin;
+	delete this->cancelLoad;
 	delete this->pattern;
+	delete this->sizeRange;
 	delete this->info;
 	delete this->stats;
 	delete this->symbols;
@@ -846,6 +1228,10 @@ SymbolViewer::~SymbolViewer() {
 	delete this->typeFilter;
 	if (this->currentNm != NULL) free(this->currentNm);
 	if (this->currentBin != NULL) free(this->currentBin);
+	if (this->cacheDir != NULL) free(this->cacheDir);
+	this->clearFilters();
+	this->clearMembers(this->memberList);
+	this->clearMembers(this->nextMemberList);
 }
 
 
@@ -874,6 +1260,10 @@ int SymbolViewer::handle(int e) {
 		if (Fl::event_key() == (FL_F + 5)) {
 			this->read(true);
 			result = 1;
+		} else if (Fl::event_key() == FL_Escape && this->loader != NULL) {
+			/* cancel loading instead of closing the window */
+			this->cancel();
+			result = 1;
 		}
 		break;
 	default:
@@ -909,13 +1299,25 @@ void SymbolViewer::onChangeBin(Fl_Input * /* input */) {
 }
 
 
+void SymbolViewer::onCancelLoad(Fl_Button * /* button */) {
+	this->cancel();
+}
+
+
 void SymbolViewer::onInformation(Fl_Button * /* button */) {
 	this->licenseWin->show();
 }
 
 
 void SymbolViewer::onChangePattern(Fl_Input * /* input */) {
-	this->update();
+	if (this->searchDelay > 0.0) {
+		/* abandon the outdated search and wait for further changes */
+		this->cancelQuery();
+		Fl::remove_timeout(SymbolViewer::onSearchDelay, this);
+		Fl::add_timeout(this->searchDelay, SymbolViewer::onSearchDelay, this);
+	} else {
+		this->update(true);
+	}
 }
 
 
@@ -923,7 +1325,7 @@ void SymbolViewer::onTableEvent(Fl_Table_Row * /* table */) {
 	if (Fl::event() != FL_PUSH || Fl::event_button() != FL_RIGHT_MOUSE) return;
 	this->typeFilter->position(Fl::event_x_root(), Fl::event_y_root());
 	this->typeFilter->show();
-	this->update();
+	this->update(true);
 }
 
 
@@ -931,8 +1333,9 @@ void SymbolViewer::onTableEvent(Fl_Table_Row * /* table */) {
  * Reads the symbol list from the binary file and updates the tables if possible.
  * 
  * @param[in] force - forces a fresh read
+ * @param[in] reload - keep showing the current symbols until the new ones are complete
  */
-void SymbolViewer::read(const bool force) {
+void SymbolViewer::read(const bool force, const bool reload) {
 	struct stat fileInfo[1];
 	/* check values */
 	if (this->nmPath->value() == NULL) return;
@@ -940,12 +1343,19 @@ void SymbolViewer::read(const bool force) {
 	if (this->binPath->value() == NULL) return;
 	if (this->binPath->value()[0] == 0) return;
 	/* check if we need to read the data again */
-	if (force == false && nullSafeStrCmp(this->nmPath->value(), this->currentNm) == 0 && nullSafeStrCmp(this->binPath->value(), this->currentBin) == 0) return;
+	const bool changed = nullSafeStrCmp(this->nmPath->value(), this->currentNm) != 0 || nullSafeStrCmp(this->binPath->value(), this->currentBin) != 0;
+	if (force == false && changed == false) return;
 	/* update current path */
 	if (this->currentNm != NULL) free(this->currentNm);
 	this->currentNm = strdup(this->nmPath->value());
 	if (this->currentBin != NULL) free(this->currentBin);
 	this->currentBin = strdup(this->binPath->value());
+	/* watch for changes to reload automatically */
+	if (this->watcher != NULL && changed) {
+		this->watcher->clear();
+		this->watcher->add(this->currentBin);
+		this->watcher->add(this->currentNm);
+	}
 	/* check paths */
 	if (fl_stat(this->nmPath->value(), fileInfo) < 0) {
 		fl_message_title("Error");
@@ -959,249 +1369,769 @@ void SymbolViewer::read(const bool force) {
 		return;
 	}
 	if (fileInfo->st_size <= 0) return;
-#ifdef PCF_IS_WIN
-	/* convert nm path to UTF-16 */
-	const size_t nmPathLen = strlen(this->nmPath->value());
-	const unsigned nmPathWLen = fl_utf8toUtf16(this->nmPath->value(), static_cast<unsigned>(nmPathLen), NULL, 0) + 1;
-	wchar_t * nmPathW = static_cast<wchar_t *>(malloc(sizeof(wchar_t) * nmPathWLen));
-	if (nmPathW == NULL) return;
-	nmPathW[fl_utf8toUtf16(this->nmPath->value(), static_cast<unsigned>(nmPathLen), reinterpret_cast<unsigned short *>(nmPathW), nmPathWLen)] = 0;
-	/* convert binary path to UTF-16 */
-	const size_t binPathLen = strlen(this->binPath->value());
-	const unsigned binPathWLen = fl_utf8toUtf16(this->binPath->value(), static_cast<unsigned>(binPathLen), NULL, 0) + 1;
-	wchar_t * binPathW = static_cast<wchar_t *>(malloc(sizeof(wchar_t) * binPathWLen));
-	if (binPathW == NULL) {
-		free(nmPathW);
+	/* abort any running load and clear the views unless reloading */
+	this->cancel();
+	this->loadId++;
+	this->reloading = reload && ( ! this->symbolList.empty() );
+	if ( ! this->reloading ) {
+		this->cancelQuery();
+		this->resetDemangling();
+		this->nameIndex->clear();
+		this->typeBuckets->clear();
+		this->symbolList.clear();
+		this->clearFilters();
+		this->clearMembers(this->memberList);
+		this->update();
+	}
+	/* read symbols in the background (the native reader is tried first) */
+	const bool demangle = this->demangleSymbols && this->lazyDemangler == NULL;
+	this->loader = new SymbolLoader(this->loadId, this->nmPath->value(), this->binPath->value(), demangle, this->nativeReader, this->cacheDir, SymbolViewer::onLoadBatch, this);
+	if ( ! this->loader->start() ) {
+		delete this->loader;
+		this->loader = NULL;
+		fl_message_title("Error");
+		fl_alert("Failed to start reading symbols from \"%s\".", this->binPath->value());
 		return;
 	}
-	binPathW[fl_utf8toUtf16(this->binPath->value(), static_cast<unsigned>(binPathLen), reinterpret_cast<unsigned short *>(binPathW), binPathWLen)] = 0;
-	/* build command-line */
-	const wchar_t * cmdW[] = {
-		nmPathW + fl_utf8toUtf16(this->nmPath->value(), static_cast<unsigned>(nmPathLen - strlen(fl_filename_name(this->nmPath->value()))), NULL, 0),
-		L"-S",
-		L"--size-sort",
-		L"-f",
-		L"bsd",
-		L"-t",
-		L"d",
-		binPathW,
-		NULL
-	};
-	/* call nm */
-	tFdioPHandle * nm = fdious_popen(nmPathW, cmdW, NULL, NULL, tFdioPMode(FDIO_USE_STDOUT | FDIO_COMBINE));
-#else /* not Windows */
-	/* build command-line */
-	const char * cmd[] = {
-		fl_filename_name(this->nmPath->value()),
-		"-S",
-		"--size-sort",
-		"-f",
-		"bsd",
-		"-t",
-		"d",
-		this->binPath->value(),
-		NULL
-	};
-	/* call nm */
-	tFdioPHandle * nm = fdios_popen(this->nmPath->value(), cmd, NULL, NULL, tFdioPMode(FDIO_USE_STDOUT | FDIO_COMBINE));
-#endif /* not Windows */
-	/* parse nm output */
-	if (nm != NULL) {
-		char * line = NULL;
-		char * firstLine = NULL;
-		char * next = NULL;
-		int len, lineSize;
+	this->showLoading(true);
+}
+
+
+/**
+ * Cancels the running load. Batches still in flight are discarded by their
+ * outdated load identifier. Partially loaded symbols are removed unless
+ * reloading, which keeps the previous symbols.
+ */
+void SymbolViewer::cancel() {
+	if (this->loader == NULL) return;
+	/* kills a running nm process instead of waiting for it */
+	delete this->loader;
+	this->loader = NULL;
+	this->loadId++;
+	if ( ! this->reloading ) {
+		this->cancelQuery();
+		this->resetDemangling();
+		this->nameIndex->clear();
+		this->typeBuckets->clear();
 		this->symbolList.clear();
-		while ( ! feof(nm->out) ) {
-			len = fdios_getline(&line, &lineSize, nm->out);
-			for (len--; (line[len] == '\n' || line[len] == '\r') && len > 0; len--);
-			if (len == 0) continue; /* ignore empty lines */
-			line[++len] = 0;
-			if (firstLine == NULL) firstLine = strdup(line);
-			/* parse line fields */
-			const long long int value = strtoll(line, &next, 10);
-			if (value == 0 && *next != ' ') continue;
-			next++;
-			const long long int size = strtoll(next, &next, 10);
-			if (size == 0 && *next != ' ') continue;
-			next++;
-			const char type = *next;
-			next++;
-			if ((!isalpha(type) && type != '?') || *next != ' ') continue;
-			next++;
-			const char * name = next;
-			if ( ! this->demangleSymbols ) {
-				const Symbol entry(type, size, strdup(name));
-				this->symbolList.push_back(entry);
-				continue;
+		this->clearFilters();
+		this->clearMembers(this->memberList);
+		this->update();
+	}
+	this->nextSymbolList.clear();
+	this->clearMembers(this->nextMemberList);
+	this->reloading = false;
+	this->showLoading(false);
+}
+
+
+/**
+ * Toggles between the browse and the cancel button of the binary path.
+ * 
+ * @param[in] loading - true if a load is running, else false
+ */
+void SymbolViewer::showLoading(const bool loading) {
+	if ( loading ) {
+		this->browseBin->hide();
+		this->cancelLoad->show();
+	} else {
+		this->cancelLoad->hide();
+		this->browseBin->show();
+	}
+}
+
+
+/**
+ * Called within the GUI thread for each batch of symbols loaded in the
+ * background. Each batch holds all symbols loaded so far sorted by size in
+ * descending order which replace the symbol list. The current lists are
+ * replaced at once by the completed new ones when reloading.
+ * 
+ * @param[in] data - SymbolLoader::Batch
+ */
+void SymbolViewer::onLoadBatch(void * data) {
+	SymbolLoader::Batch * batch = static_cast<SymbolLoader::Batch *>(data);
+	if (batch == NULL) return;
+	SymbolViewer * self = static_cast<SymbolViewer *>(batch->userData);
+	if (self == NULL || batch->id != self->loadId) {
+		/* outdated */
+		delete batch;
+		return;
+	}
+	/* a failed reload keeps the current symbol list including its type buckets */
+	bool replaced = ! self->reloading;
+	if ( replaced ) {
+		self->cancelQuery();
+		self->resetDemangling();
+		self->nameIndex->clear();
+		self->typeBuckets->clear();
+	}
+	SymbolList & symList = self->reloading ? self->nextSymbolList : self->symbolList;
+	MemberList & memList = self->reloading ? self->nextMemberList : self->memberList;
+	/* take over archive members and all symbols loaded so far (the previous ones are freed with the batch) */
+	memList.insert(memList.end(), batch->members.begin(), batch->members.end());
+	batch->members.clear();
+	if (( ! batch->symbols.empty() ) || ( ! symList.empty() )) {
+		symList.swap(batch->symbols);
+		if ( ! self->reloading ) self->clearFilters();
+	}
+	if ( self->reloading ) {
+		if ( ! batch->done ) {
+			delete batch;
+			return;
+		}
+		/* keep the current lists if the reload failed (e.g. binary was replaced again) */
+		if ( ! self->nextSymbolList.empty() ) {
+			self->cancelQuery();
+			self->resetDemangling();
+			self->nameIndex->clear();
+			self->typeBuckets->clear();
+			self->clearFilters();
+			self->symbolList.swap(self->nextSymbolList);
+			self->memberList.swap(self->nextMemberList);
+			replaced = true;
+		}
+		self->nextSymbolList.clear();
+		self->clearMembers(self->nextMemberList);
+		self->reloading = false;
+	}
+	/* show the member column for archives only */
+	if (self->memberList.empty() && self->symbols->col_width(2) > 0) {
+		self->symbols->col_width(3, self->symbols->col_width(3) + self->symbols->col_width(2));
+		self->symbols->col_width(2, 0);
+	} else if (( ! self->memberList.empty() ) && self->symbols->col_width(2) <= 0) {
+		const int memberW = self->symbols->col_width(3) / 3;
+		self->symbols->col_width(2, memberW);
+		self->symbols->col_width(3, self->symbols->col_width(3) - memberW);
+	}
+	/* update view data; any query reading the buckets was cancelled above */
+	if (batch->done && replaced) self->typeBuckets->build(self->symbolList);
+	self->update();
+	if ( batch->done ) {
+		delete self->loader;
+		self->loader = NULL;
+		self->showLoading(false);
+		self->demangleAll();
+		self->buildIndex();
+		if ( self->symbolList.empty() ) {
+			self->clearMembers(self->memberList);
+			fl_message_title("Error");
+			fl_alert("Failed to read symbols from \"%s\".\n%s", self->binPath->value(), batch->error != NULL ? batch->error : "");
+		}
+	}
+	delete batch;
+}
+
+
+/**
+ * Called within the GUI thread once the watched binary or nm changed.
+ * 
+ * @param[in] data - SymbolViewer
+ */
+void SymbolViewer::onFileChange(void * data) {
+	SymbolViewer * self = static_cast<SymbolViewer *>(data);
+	if (self == NULL) return;
+	self->read(true, true);
+}
+
+
+/**
+ * Called within the GUI thread once all symbol names have been demangled in
+ * the background.
+ * 
+ * @param[in] data - SymbolViewer
+ */
+void SymbolViewer::onDemangled(void * data) {
+	SymbolViewer * self = static_cast<SymbolViewer *>(data);
+	if (self == NULL || self->lazyDemangler == NULL) return;
+	/* the names are replaced */
+	self->cancelQuery();
+	self->nameIndex->clear();
+	if ( ! self->lazyDemangler->finish(self->symbolList) ) return;
+	self->clearFilters();
+	self->buildIndex();
+	/* names are demangled from now on */
+	static_cast<SymsListView *>(self->symbols)->userData.demangler = NULL;
+	self->update();
+}
+
+
+/**
+ * Called within the GUI thread once the search pattern did not change for the
+ * configured delay.
+ * 
+ * @param[in] data - SymbolViewer
+ */
+void SymbolViewer::onSearchDelay(void * data) {
+	SymbolViewer * self = static_cast<SymbolViewer *>(data);
+	if (self == NULL) return;
+	self->update(true);
+}
+
+
+/**
+ * Stops demangling all symbol names in the background and switches back to
+ * demangling on demand. Needs to be called before the symbol list changes.
+ */
+void SymbolViewer::resetDemangling() {
+	if (this->lazyDemangler == NULL) return;
+	this->lazyDemangler->cancel();
+	static_cast<SymsListView *>(this->symbols)->userData.demangler = this->lazyDemangler;
+}
+
+
+/**
+ * Starts to demangle all symbol names in the background if demangling on
+ * demand and the current pattern needs demangled names. The pattern is
+ * matched against the mangled names until done.
+ */
+void SymbolViewer::demangleAll() {
+	if (this->lazyDemangler == NULL || this->loader != NULL || this->symbolList.empty()) return;
+	if (static_cast<SymsListView *>(this->symbols)->userData.demangler == NULL) return; /* already done */
+	if ( this->lazyDemangler->isDemanglingAll() ) return;
+	if ( ! queryNeedsDemangledNames(this->pattern->value(), this->ignoreCase) ) return;
+	this->lazyDemangler->demangleAll(this->symbolList);
+}
+
+
+/**
+ * Starts to build the name index for the current symbol list in the
+ * background if it is large enough. The list is searched without index until
+ * done.
+ */
+void SymbolViewer::buildIndex() {
+	if (this->loader != NULL || this->symbolList.size() < INDEX_MIN_SYMBOLS) return;
+	this->nameIndex->build(this->symbolList);
+}
+
+
+/**
+ * Removes all previous filter results. Needs to be called once the symbol
+ * list changes as the results reference its symbols by index.
+ */
+void SymbolViewer::clearFilters() {
+	for (FilterStack::iterator it = this->filterStack.begin(); it != this->filterStack.end(); ++it) {
+		free((*it)->pattern);
+		delete *it;
+	}
+	this->filterStack.clear();
+	this->clearResults();
+}
+
+
+/**
+ * Takes the result of the given search from the result cache if the same
+ * search was done before on the current symbol list.
+ *
+ * @param[in,out] q - search (receives the result)
+ * @return true if found, else false
+ */
+bool SymbolViewer::loadResult(Query & q) {
+	for (ResultCache::iterator it = this->resultCache.begin(); it != this->resultCache.end(); ++it) {
+		CachedResult * result = *it;
+		if (result->generation != q.symbolGeneration || result->types != q.types || result->minSize != q.minSize || result->maxSize != q.maxSize) continue;
+		if (result->query != (q.plan != NULL)) continue;
+		if (strcmp(result->pattern, q.pattern) != 0) continue;
+		q.rows = result->rows;
+		q.total = result->total;
+		for (size_t n = 0; n < 27; n++) q.typeStats[n] = result->typeStats[n];
+		q.memberStats = result->memberStats;
+		q.cached = true;
+		/* most recently used last */
+		this->resultCache.erase(it);
+		this->resultCache.push_back(result);
+		return true;
+	}
+	return false;
+}
+
+
+/**
+ * Adds the result of the given search to the result cache. The least
+ * recently used results are removed if the cache is full.
+ *
+ * @param[in] q - finished search
+ */
+void SymbolViewer::storeResult(const Query & q) {
+	if (q.cached || q.pattern == NULL || q.symbolGeneration != this->symbolGeneration) return;
+	if (this->loader != NULL) return; /* symbol list still changes */
+	if (q.rows.size() != q.total.symbols || q.rows.size() > RESULT_CACHE_ROWS) return; /* limited or too large */
+	size_t rows = q.rows.size();
+	for (ResultCache::const_iterator it = this->resultCache.begin(); it != this->resultCache.end(); ++it) {
+		rows += (*it)->rows.size();
+	}
+	while ( ! this->resultCache.empty() ) {
+		if (this->resultCache.size() < RESULT_CACHE_SIZE && rows <= RESULT_CACHE_ROWS) break;
+		CachedResult * oldest = this->resultCache.front();
+		rows -= oldest->rows.size();
+		free(oldest->pattern);
+		delete oldest;
+		this->resultCache.erase(this->resultCache.begin());
+	}
+	CachedResult * result = new CachedResult();
+	result->pattern = strdup(q.pattern);
+	result->types = q.types;
+	result->minSize = q.minSize;
+	result->maxSize = q.maxSize;
+	result->generation = q.symbolGeneration;
+	result->query = q.plan != NULL;
+	result->rows = q.rows;
+	result->total = q.total;
+	for (size_t n = 0; n < 27; n++) result->typeStats[n] = q.typeStats[n];
+	result->memberStats = q.memberStats;
+	this->resultCache.push_back(result);
+}
+
+
+/**
+ * Removes all cached search results. A new symbol list generation is started
+ * as the results reference the symbols by index.
+ */
+void SymbolViewer::clearResults() {
+	for (ResultCache::iterator it = this->resultCache.begin(); it != this->resultCache.end(); ++it) {
+		free((*it)->pattern);
+		delete *it;
+	}
+	this->resultCache.clear();
+	this->symbolGeneration++;
+}
+
+
+/**
+ * Frees the given archive member list.
+ * 
+ * @param[in,out] list - list to clear
+ */
+void SymbolViewer::clearMembers(MemberList & list) {
+	for (MemberList::iterator it = list.begin(); it != list.end(); ++it) {
+		if (*it != NULL) free(*it);
+	}
+	list.clear();
+}
+
+
+/**
+ * Cancels the running search. Needs to be called before the symbol list, the
+ * name index, the type buckets or the filter results change.
+ */
+void SymbolViewer::cancelQuery() {
+	if (this->query == NULL) return;
+	__atomic_store_n(&(this->query->cancelled), 1, __ATOMIC_RELEASE);
+	thread_join(this->query->thread);
+	delete this->query;
+	this->query = NULL;
+}
+
+
+/**
+ * Updates the symbol tables. A search in the background replaces the tables
+ * once done. Any running search is cancelled first.
+ *
+ * @param[in] background - search in the background instead of the calling thread
+ */
+void SymbolViewer::update(const bool background) {
+	this->cancelQuery();
+	const SymbolList & list = this->symbolList;
+	Query * q = new Query(this, ++(this->queryGeneration));
+	
+	const char * text = (this->pattern->value() != NULL) ? this->pattern->value() : "";
+	q->local = this->typeFilter->isSet(-2);
+	q->global = this->typeFilter->isSet(-1);
+	
+	for (size_t n = 0; n < 27; n++) {
+		q->filter[n] = this->typeFilter->isSet(int(n));
+	}
+	
+	/* an invalid size range is ignored and shown in red */
+	const bool validRange = SymbolQuery::parseSizeRange(this->sizeRange->value(), q->minSize, q->maxSize);
+	if (this->sizeRange->textcolor() != (validRange ? FL_FOREGROUND_COLOR : FL_RED)) {
+		this->sizeRange->textcolor(validRange ? FL_FOREGROUND_COLOR : FL_RED);
+		this->sizeRange->redraw();
+	}
+	
+	/* an invalid query is searched as plain pattern and shown in red */
+	q->plan = new SymbolQuery();
+	const bool validQuery = q->plan->parse(text, this->ignoreCase);
+	if (this->pattern->textcolor() != (validQuery ? FL_FOREGROUND_COLOR : FL_RED)) {
+		this->pattern->textcolor(validQuery ? FL_FOREGROUND_COLOR : FL_RED);
+		this->pattern->redraw();
+	}
+	const char * pat = text;
+	const bool simpleQuery = validQuery && q->plan->isSimple(this->ignoreCase);
+	if ( simpleQuery ) {
+		/* the predicates only narrow the type filter and the size range */
+		const SymbolQuery::Clause & clause = q->plan->getClause(0);
+		for (size_t n = 0; n < 27; n++) {
+			q->filter[n] = q->filter[n] && (clause.types & (boost::uint32_t(1) << n)) != 0;
+		}
+		q->local = q->local && clause.local;
+		q->global = q->global && clause.global;
+		q->minSize = std::max(q->minSize, clause.minSize);
+		q->maxSize = std::min(q->maxSize, clause.maxSize);
+		pat = q->plan->getSimplePattern();
+	}
+	
+	q->types = 0;
+	for (size_t n = 0; n < 27; n++) {
+		if ( q->filter[n] ) q->types |= boost::uint32_t(1) << n;
+	}
+	if ( q->global ) q->types |= boost::uint32_t(1) << 27;
+	if ( q->local ) q->types |= boost::uint32_t(1) << 28;
+	
+	q->pattern = strdup(pat);
+	if (( ! validQuery ) || simpleQuery) {
+		/* searched without query */
+		delete q->plan;
+		q->plan = NULL;
+		pat = q->pattern;
+	}
+	
+	/* find the most specific previous result which this filter refines */
+	while (q->plan == NULL && ( ! this->filterStack.empty() )) {
+		FilterResult * last = this->filterStack.back();
+		if ( refinesFilter(pat, q->types, q->minSize, q->maxSize, *last) ) {
+			q->base = last;
+			break;
+		}
+		free(last->pattern);
+		delete last;
+		this->filterStack.pop_back();
+	}
+	const bool samePattern = q->base != NULL && strcmp(pat, q->base->pattern) == 0;
+	q->sameFilter = samePattern && q->types == q->base->types && q->minSize == q->base->minSize && q->maxSize == q->base->maxSize;
+	q->hasPattern = *pat != 0 && ( ! samePattern );
+	q->index = (q->hasPattern && this->nameIndex->isReady(list)) ? this->nameIndex : NULL;
+	q->buckets = ((*pat == 0 || q->plan != NULL) && this->typeBuckets->isReady(list)) ? this->typeBuckets : NULL;
+	q->limit = this->topSymbols;
+	q->symbolGeneration = this->symbolGeneration;
+	
+	q->memberStats.reserve(this->memberList.size());
+	for (size_t n = 0; n < this->memberList.size(); n++) {
+		q->memberStats.push_back(Statistics('?', 0, 0, int(n)));
+	}
+	
+	/* a recent search is taken from the cache at once */
+	if (background && ( ! this->loadResult(*q) )) {
+		q->background = true;
+		q->thread = thread_create(SymbolViewer::queryMain, q);
+		if (q->thread != NULL) {
+			this->query = q;
+			return;
+		}
+		q->background = false;
+	}
+	if (( ! q->cached ) && ( ! this->loadResult(*q) )) runQuery(*q);
+	this->applyQuery(*q);
+	delete q;
+}
+
+
+/**
+ * Background thread function of a search.
+ *
+ * @param[in,out] param - pointer to Query
+ */
+void SymbolViewer::queryMain(void * param) {
+	Query * q = static_cast<Query *>(param);
+	runQuery(*q);
+	__atomic_store_n(&(q->finished), 1, __ATOMIC_RELEASE);
+	awake(SymbolViewer::onQueryDone, q->viewer, &(q->cancelled));
+}
+
+
+/**
+ * Called within the GUI thread once the search in the background finished.
+ *
+ * @param[in] data - SymbolViewer
+ */
+void SymbolViewer::onQueryDone(void * data) {
+	SymbolViewer * self = static_cast<SymbolViewer *>(data);
+	if (self == NULL || self->query == NULL) return;
+	Query * q = self->query;
+	if (__atomic_load_n(&(q->finished), __ATOMIC_ACQUIRE) == 0) return;
+	thread_join(q->thread);
+	self->query = NULL;
+	/* only the latest search updates the tables */
+	if (q->generation == self->queryGeneration && q->cancelled == 0) self->applyQuery(*q);
+	delete q;
+}
+
+
+/**
+ * Called within the GUI thread once the search in the background found the
+ * first symbols up to the limit. These are shown until the statistics are
+ * complete.
+ *
+ * @param[in] data - SymbolViewer
+ */
+void SymbolViewer::onQueryRows(void * data) {
+	SymbolViewer * self = static_cast<SymbolViewer *>(data);
+	if (self == NULL || self->query == NULL) return;
+	Query * q = self->query;
+	if (q->rowsShown || __atomic_load_n(&(q->rowsReady), __ATOMIC_ACQUIRE) == 0) return;
+	q->rowsShown = true;
+	if (q->generation != self->queryGeneration || q->cancelled != 0) return;
+	StatsListView & statsView = *static_cast<StatsListView *>(self->stats);
+	SymsListView & symsView = *static_cast<SymsListView *>(self->symbols);
+	/* the totals are unknown until done */
+	statsView.listData.clear();
+	statsView.userData.total = Statistics('_');
+	symsView.listData = q->topRows;
+	symsView.userData.total = Statistics('_');
+	statsView.update();
+	symsView.update();
+}
+
+
+/**
+ * Filters the symbols by the given search. This may be called outside the
+ * GUI thread. The symbol list, name index and filter results may not change
+ * until done.
+ *
+ * @param[in,out] q - search
+ */
+void SymbolViewer::runQuery(Query & q) {
+	const SymbolList & list = q.viewer->symbolList;
+	const FilterResult * base = q.base;
+	const char * pat = q.pattern;
+	if (pat == NULL) return;
+	
+	/* the symbols within the size range form a slice as the list is sorted by size in descending order */
+	const std::vector<long long int> & sizes = list.getSizes();
+	size_t first, last;
+	sizeSlice(sizes, q.minSize, q.maxSize, first, last);
+	/* rows of the previous result within this slice (in ascending symbol order) */
+	const SymbolRow * baseRows = NULL;
+	size_t count = last - first;
+	if (base != NULL) {
+		const std::vector<SymbolRow>::const_iterator from = std::lower_bound(base->rows.begin(), base->rows.end(), boost::uint32_t(first), byRowIndex);
+		const std::vector<SymbolRow>::const_iterator to = std::lower_bound(from, base->rows.end(), boost::uint32_t(last), byRowIndex);
+		count = size_t(to - from);
+		if (count > 0) baseRows = &(*from);
+	}
+	
+	/* without pattern the symbols of the selected types are merged from the type buckets */
+	if (q.buckets != NULL && q.plan == NULL) {
+		bool selected[TypeBuckets::COUNT];
+		selectBuckets(q.filter, q.local, q.global, NULL, selected);
+		std::vector<boost::uint32_t> merged;
+		if ( ! q.buckets->merge(selected, first, last, q.limit, merged, &(q.cancelled)) ) return;
+		for (size_t b = 0; b < size_t(TypeBuckets::COUNT); b++) {
+			if ( ! selected[b] ) continue;
+			Statistics * typeStat = (b < size_t(TypeBuckets::UNKNOWN)) ? (q.typeStats + (b % 26)) : ((b == size_t(TypeBuckets::UNKNOWN)) ? (q.typeStats + 26) : NULL);
+			addBucketTotals(list, q.buckets->getBucket(b), first, last, q.total, typeStat, q.memberStats);
+		}
+		q.rows.reserve(merged.size());
+		for (std::vector<boost::uint32_t>::const_iterator it = merged.begin(); it != merged.end(); ++it) {
+			q.rows.push_back(SymbolRow(*it));
+		}
+		return;
+	}
+	
+	/* create filtered lists (only from the previous result if refined) */
+	const bool hasPattern = q.hasPattern && q.plan == NULL;
+	const bool isSubstring = hasPattern && xstrpbrk(pat, "*?#") == NULL;
+	/* compile the pattern once per update (no matches if this fails) */
+	tStrSearch * substring = isSubstring ? strsearch_create(pat, strlen(pat), q.viewer->ignoreCase ? 1 : 0) : NULL;
+	tWildcard * wildcard = (hasPattern && ( ! isSubstring )) ? wildcard_create(pat, q.viewer->ignoreCase ? 1 : 0) : NULL;
+	/* take the candidates from the name index or scan all names at once */
+	/* unless only few candidates are left from the previous result or the size range */
+	const bool manyCandidates = (count * 8) >= list.size();
+	std::vector<boost::uint32_t> candidates;
+	bool useCandidates = hasPattern && q.index != NULL && manyCandidates && q.index->find(pat, candidates);
+	if ( useCandidates ) {
+		/* both are in ascending order */
+		trimToSlice(candidates, first, last);
+		if (base != NULL) {
+			std::vector<boost::uint32_t>::iterator out = candidates.begin();
+			const SymbolRow * row = baseRows;
+			const SymbolRow * rowEnd = baseRows + count;
+			for (std::vector<boost::uint32_t>::const_iterator it = candidates.begin(); it != candidates.end(); ++it) {
+				while (row != rowEnd && row->index < *it) ++row;
+				if (row != rowEnd && row->index == *it) *out++ = *it;
 			}
-			/* demangle symbol */
-			char * compilerAttr = NULL;
-			size_t compilerAttrLen = 0;
-			char * attribute;
-			const char * symStart = strstr(name, "_Z");
-			if (symStart == NULL) {
-				symStart = name;
+			candidates.erase(out, candidates.end());
+		}
+	}
+	size_t rangeFirst = first;
+	if (q.plan != NULL) {
+		/* a query is checked per symbol; the candidates of each clause are */
+		/* taken from the name index, the type buckets or the size range */
+		std::vector<boost::uint32_t> clauseRows, merged, both;
+		size_t hullFirst = last;
+		size_t hullLast = first;
+		for (size_t c = 0; c < q.plan->size(); c++) {
+			const SymbolQuery::Clause & clause = q.plan->getClause(c);
+			size_t clauseFirst, clauseLast;
+			sizeSlice(sizes, std::max(clause.minSize, q.minSize), std::min(clause.maxSize, q.maxSize), clauseFirst, clauseLast);
+			if (clauseFirst >= clauseLast) continue;
+			const SymbolQuery::Term * name = NULL;
+			for (std::vector<SymbolQuery::Term>::const_iterator it = clause.terms.begin(); name == NULL && it != clause.terms.end(); ++it) {
+				if (it->pattern != NULL && ( ! it->negated )) name = &(*it);
 			}
-			attribute = strchr(symStart, '.');
-			if (attribute != NULL) {
-				compilerAttr = strdup(attribute);
-				if (compilerAttr == NULL) {
-					break;
-				}
+			bool selected[TypeBuckets::COUNT];
+			const bool restricted = selectBuckets(q.filter, q.local, q.global, &clause, selected);
+			bool found = false;
+			if (name != NULL && q.index != NULL && ((clauseLast - clauseFirst) * 8) >= list.size()) {
+				found = q.index->find(name->pattern, clauseRows);
+				if ( found ) trimToSlice(clauseRows, clauseFirst, clauseLast);
 			}
-			if (compilerAttr != NULL) {
-				attribute[0] = 0;
-				compilerAttrLen = strlen(compilerAttr) + 1;
+			if (( ! found ) && restricted && q.buckets != NULL) {
+				found = q.buckets->merge(selected, clauseFirst, clauseLast, 0, clauseRows, &(q.cancelled));
 			}
-			int status;
-			char * realSymName = abi::__cxa_demangle(symStart, 0, 0, &status);
-			if (status == 0) {
-				/* got demangled name */
-				if (symStart == name) {
-					if (compilerAttr == NULL) {
-						const Symbol entry(type, size, strdup(realSymName));
-						this->symbolList.push_back(entry);
-					} else {
-						const size_t realSymLen = strlen(realSymName);
-						char * newName = static_cast<char *>(malloc(sizeof(char) * (realSymLen + compilerAttrLen + 1)));
-						if (newName != NULL) {
-							memcpy(newName, realSymName, realSymLen);
-							memcpy(newName + realSymLen, compilerAttr, compilerAttrLen);
-							const Symbol entry(type, size, newName);
-							this->symbolList.push_back(entry);
-						} else {
-							const Symbol entry(type, size, strdup(realSymName));
-							this->symbolList.push_back(entry);
-						}
-					}
-				} else {
-					const size_t realSymLen = strlen(realSymName);
-					char * newName = static_cast<char *>(malloc(sizeof(char) * (realSymLen + compilerAttrLen + symStart - name + 1)));
-					if (newName != NULL) {
-						memcpy(newName, name, sizeof(char) * (symStart - name));
-						memcpy(newName + (symStart - name), realSymName, sizeof(char) * (realSymLen + 1));
-						if (compilerAttr != NULL) {
-							memcpy(newName + realSymLen + (symStart - name), compilerAttr, compilerAttrLen);
-						}
-						const Symbol entry(type, size, newName);
-						this->symbolList.push_back(entry);
-					} else {
-						const Symbol entry(type, size, strdup(realSymName));
-						this->symbolList.push_back(entry);
-					}
-				}
+			if ( found ) {
+				both.clear();
+				std::set_union(merged.begin(), merged.end(), clauseRows.begin(), clauseRows.end(), std::back_inserter(both));
+				merged.swap(both);
 			} else {
-				/* failed to demangle symbol */
-				if (compilerAttr == NULL) {
-					const Symbol entry(type, size, strdup(name));
-					this->symbolList.push_back(entry);
-				} else {
-					const size_t realSymLen = strlen(name);
-					char * newName = static_cast<char *>(malloc(sizeof(char) * (realSymLen + compilerAttrLen + 1)));
-					if (newName != NULL) {
-						memcpy(newName, name, realSymLen);
-						memcpy(newName + realSymLen, compilerAttr, compilerAttrLen);
-						const Symbol entry(type, size, newName);
-						this->symbolList.push_back(entry);
-					} else {
-						const Symbol entry(type, size, strdup(name));
-						this->symbolList.push_back(entry);
-					}
+				hullFirst = std::min(hullFirst, clauseFirst);
+				hullLast = std::max(hullLast, clauseLast);
+			}
+		}
+		if (hullFirst < hullLast) {
+			/* check all symbols within the range covering every clause */
+			if ( ! merged.empty() ) {
+				hullFirst = std::min(hullFirst, size_t(merged.front()));
+				hullLast = std::max(hullLast, size_t(merged.back()) + 1);
+			}
+			rangeFirst = hullFirst;
+			count = hullLast - hullFirst;
+		} else {
+			candidates.swap(merged);
+			useCandidates = true;
+		}
+	}
+	std::vector<boost::uint32_t> matchingNames;
+	const bool scanNames = substring != NULL && manyCandidates && ( ! useCandidates );
+	if ( scanNames ) list.getNames().find(substring, matchingNames, &(q.cancelled));
+	FilterContext ctx(list);
+	ctx.candidates = (useCandidates && ( ! candidates.empty() )) ? &(candidates[0]) : NULL;
+	ctx.rows = baseRows;
+	ctx.first = rangeFirst;
+	ctx.count = useCandidates ? candidates.size() : count;
+	ctx.filter = q.filter;
+	ctx.local = q.local;
+	ctx.global = q.global;
+	ctx.substring = scanNames ? NULL : substring;
+	ctx.wildcard = wildcard;
+	ctx.matchingNames = scanNames ? &matchingNames : NULL;
+	ctx.query = q.plan;
+	ctx.cancelled = &(q.cancelled);
+	if (hasPattern && substring == NULL && wildcard == NULL) ctx.count = 0; /* failed to compile the pattern */
+	ctx.chunks.resize((ctx.count + FILTER_CHUNK_SIZE - 1) / FILTER_CHUNK_SIZE);
+	/* filter in parallel; each thread collects its own statistics */
+	std::vector<FilterWorker> workers(std::max(size_t(1), std::min(q.viewer->filterPool->size(), ctx.chunks.size())));
+	for (std::vector<FilterWorker>::iterator it = workers.begin(); it != workers.end(); ++it) {
+		it->ctx = &ctx;
+		it->members.resize(q.memberStats.size());
+	}
+	/* the first matches are the largest ones; with a limit these are shown */
+	/* as soon as found while the statistics are completed afterwards */
+	bool needRows = q.limit > 0 && q.background;
+	ctx.end = needRows ? std::min(ctx.chunks.size(), workers.size()) : ctx.chunks.size();
+	for (;;) {
+		runWorkers(*(q.viewer->filterPool), workers);
+		ctx.next = ctx.end;
+		if (ctx.end >= ctx.chunks.size() || __atomic_load_n(&(q.cancelled), __ATOMIC_ACQUIRE) != 0) break;
+		if ( needRows ) {
+			size_t found = 0;
+			for (size_t n = 0; n < ctx.end && found < q.limit; n++) found += ctx.chunks[n].size();
+			if (found >= q.limit) {
+				q.topRows.reserve(q.limit);
+				for (size_t n = 0; q.topRows.size() < q.limit; n++) {
+					const size_t take = std::min(ctx.chunks[n].size(), q.limit - q.topRows.size());
+					q.topRows.insert(q.topRows.end(), ctx.chunks[n].begin(), ctx.chunks[n].begin() + take);
 				}
+				__atomic_store_n(&(q.rowsReady), 1, __ATOMIC_RELEASE);
+				awake(SymbolViewer::onQueryRows, q.viewer, &(q.cancelled));
+				needRows = false;
 			}
-			if (realSymName != NULL) free(realSymName);
-			if (compilerAttr != NULL) free(compilerAttr);
 		}
-		if ( this->symbolList.empty() ) {
-			fl_message_title("Error");
-			fl_alert("Failed to read symbols from \"%s\".\n%s", this->binPath->value(), firstLine != NULL ? firstLine : "");
+		/* process twice as many chunks until enough matches were found */
+		ctx.end = needRows ? std::min(ctx.chunks.size(), ctx.end * 2) : ctx.chunks.size();
+	}
+	if (substring != NULL) strsearch_free(substring);
+	if (wildcard != NULL) wildcard_free(wildcard);
+	if (__atomic_load_n(&(q.cancelled), __ATOMIC_ACQUIRE) != 0) return;
+	/* merge the results (chunks are in symbol order) */
+	size_t matches = 0;
+	for (size_t n = 0; n < ctx.chunks.size(); n++) matches += ctx.chunks[n].size();
+	q.rows.reserve(matches);
+	for (size_t n = 0; n < ctx.chunks.size(); n++) {
+		q.rows.insert(q.rows.end(), ctx.chunks[n].begin(), ctx.chunks[n].end());
+	}
+	for (std::vector<FilterWorker>::const_iterator it = workers.begin(); it != workers.end(); ++it) {
+		q.total.size += it->total.size;
+		q.total.symbols += it->total.symbols;
+		for (size_t n = 0; n < 27; n++) {
+			q.typeStats[n].size += it->types[n].size;
+			q.typeStats[n].symbols += it->types[n].symbols;
+		}
+		for (size_t n = 0; n < q.memberStats.size(); n++) {
+			q.memberStats[n].size += it->members[n].size;
+			q.memberStats[n].symbols += it->members[n].symbols;
 		}
-		if (firstLine != NULL) free(firstLine);
-		if (line != NULL) free(line);
 	}
-#ifdef PCF_IS_WIN
-	if (nm != NULL) fdious_pclose(nm);
-	free(nmPathW);
-	free(binPathW);
-#else
-	if (nm != NULL) fdios_pclose(nm);
-#endif
-	/* sort by size in descending order */
-	std::stable_sort(this->symbolList.begin(), this->symbolList.end(), bySizeReverseOrder<Symbol>);
-	/* update view data */
-	this->update();
 }
 
 
 /**
- * Updates the symbol tables.
+ * Replaces the symbol tables by the result of the given search.
+ *
+ * @param[in,out] q - finished search (the result is moved)
  */
-void SymbolViewer::update() {
+void SymbolViewer::applyQuery(Query & q) {
 	StatsListView & statsView = *static_cast<StatsListView *>(this->stats);
 	SymsListView & symsView = *static_cast<SymsListView *>(this->symbols);
-	SymbolList::const_iterator sym, symEnd = this->symbolList.end();
 	
-	const char * pat = this->pattern->value();
-	Statistics newStats[27];
-	bool filter[27];
-	Statistics * aStat;
-	const bool local = this->typeFilter->isSet(-2);
-	const bool global = this->typeFilter->isSet(-1);
-	
-	for (size_t n = 0; n < 26; n++) {
-		newStats[n] = Statistics(char('A' + n));
-		filter[n] = this->typeFilter->isSet(int(n));
-	}
-	newStats[26] = Statistics();
-	filter[26] = this->typeFilter->isSet(26);
+	this->storeResult(q);
 	
 	statsView.listData.clear();
-	symsView.listData.clear();
-	statsView.userData = Statistics('_');
+	if (q.limit > 0 && q.rows.size() > q.limit) {
+		symsView.listData.assign(q.rows.begin(), q.rows.begin() + std::ptrdiff_t(q.limit));
+	} else {
+		symsView.listData = q.rows;
+	}
+	statsView.userData.total = q.total;
+	symsView.userData.total = q.total;
 	
-	/* create filtered lists */
-	for (sym = this->symbolList.begin(); sym != symEnd; ++sym) {
-		/* skip if pattern does not match (or substring not included if no real pattern given) */
-		if (pat != NULL && *pat != 0) {
-			if (xstrpbrk(pat, "*?#") == NULL) {
-				if (strstr(sym->name, pat) == NULL) continue;
-			} else if ( ! matchPattern(sym->name, pat) ) {
-				continue;
-			}
-		}
-		aStat = NULL;
-		if ( isalpha(sym->type) ) {
-			/* filter by type */
-			if ( ! filter[int(toupper(sym->type) - 'A')] ) continue;
-			if (islower(sym->type) && !local) continue;
-			if (isupper(sym->type) && !global) continue;
-			aStat = newStats + int(toupper(sym->type) - 'A');
-		} else if (sym->type == '?') {
-			/* filter by type */
-			if ( ! filter[26] ) continue;
-			aStat = newStats + 26;
-		}
-		symsView.listData.push_back(*sym);
-		if (sym->size > 0) {
-			statsView.userData.size += sym->size;
-		}
-		statsView.userData.symbols++;
-		if (aStat != NULL) {
-			aStat->size += sym->size;
-			aStat->symbols++;
+	/* keep the whole result for refinement by the next filter (not if limited or by query) */
+	if (( ! q.sameFilter ) && q.pattern != NULL && q.plan == NULL && q.rows.size() == q.total.symbols) {
+		FilterResult * result = new FilterResult();
+		result->pattern = q.pattern;
+		result->types = q.types;
+		result->minSize = q.minSize;
+		result->maxSize = q.maxSize;
+		result->rows.swap(q.rows);
+		q.pattern = NULL;
+		if (this->filterStack.size() >= FILTER_STACK_SIZE) {
+			/* drop the second result to keep the broadest one as base */
+			const FilterStack::iterator second = this->filterStack.begin() + 1;
+			free((*second)->pattern);
+			delete *second;
+			this->filterStack.erase(second);
 		}
+		this->filterStack.push_back(result);
 	}
-	symsView.userData = statsView.userData;
 	
-	if ( ! symsView.listData.empty() ) statsView.listData.push_back(statsView.userData);
+	this->demangleAll();
+	
+	if ( ! symsView.listData.empty() ) statsView.listData.push_back(statsView.userData.total);
 	for (size_t n = 0; n < 27; n++) {
-		if (newStats[n].symbols <= 0) continue;
-		statsView.listData.push_back(newStats[n]);
+		if (q.typeStats[n].symbols <= 0) continue;
+		statsView.listData.push_back(q.typeStats[n]);
 	}
 	
 	std::stable_sort(statsView.listData.begin(), statsView.listData.end(), bySizeReverseOrder<Statistics>);
 	
+	/* append archive member statistics after the type statistics */
+	const size_t typeRows = statsView.listData.size();
+	for (std::vector<Statistics>::const_iterator it = q.memberStats.begin(); it != q.memberStats.end(); ++it) {
+		if (it->symbols <= 0) continue;
+		statsView.listData.push_back(*it);
+	}
+	std::stable_sort(statsView.listData.begin() + std::ptrdiff_t(typeRows), statsView.listData.end(), bySizeReverseOrder<Statistics>);
+	
 	statsView.update();
 	symsView.update();
 }
@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2017-2023 Daniel Starke
  * @date 2017-12-01
- * @version 2023-04-16
+ * @version 2026-10-16
  */
 #ifndef __PCF_GUI_SYMBOLVIEWER_HPP__
 #define __PCF_GUI_SYMBOLVIEWER_HPP__
@@ -16,6 +16,7 @@
 #include <FL/Fl_Native_File_Chooser.H>
 #include <FL/Fl_Table_Row.H>
 #include <pcf/gui/DroppableReadOnlyInput.hpp>
+#include <pcf/gui/SymbolList.hpp>
 #include <pcf/gui/Utility.hpp>
 
 
@@ -24,8 +25,14 @@ namespace gui {
 
 
 /* forward declarations */
+class FileWatcher;
+class LazyDemangler;
 class LicenseInfoWindow;
+class SymbolLoader;
+class TrigramIndex;
+class TypeBuckets;
 class TypeFilterPopup;
+class WorkerPool;
 
 
 /**
@@ -33,61 +40,98 @@ class TypeFilterPopup;
  */
 class SymbolViewer : public Fl_Double_Window {
 public:
+	typedef std::vector<char *> MemberList;
+	
+	struct ViewContext;
+	
 	struct Statistics {
 		char type;
 		long long int size;
 		size_t symbols;
+		int member; /* index into the member list or -1 for type statistics */
 		
-		explicit Statistics(const char aType = '?', const long long int aSize = 0, const size_t aSymbols = 0):
+		explicit Statistics(const char aType = '?', const long long int aSize = 0, const size_t aSymbols = 0, const int aMember = -1):
 			type(aType),
 			size(aSize),
-			symbols(aSymbols)
+			symbols(aSymbols),
+			member(aMember)
 		{}
 		
-		const char * operator() (const size_t i, const Statistics & userData) const;
+		const char * operator() (const size_t i, const ViewContext & userData) const;
 	};
 	
-	struct Symbol {
-		char type;
-		long long int size;
-		char * name; /* automatically freed on destruction */
+	/** Symbol table row which references a symbol of ViewContext::symbols. */
+	struct SymbolRow {
+		boost::uint32_t index;
 		
-		explicit Symbol(const char aType = '?', const long long int aSize = 0, char * aName = NULL):
-			type(aType),
-			size(aSize),
-			name(aName)
+		explicit SymbolRow(const boost::uint32_t aIndex = 0):
+			index(aIndex)
 		{}
 		
-		Symbol(const Symbol & o):
-			type(o.type),
-			size(o.size),
-			name(strdup(o.name))
-		{}
+		const char * operator() (const size_t i, const ViewContext & userData) const;
+	};
+	
+	/** Filtered symbol rows which can be refined by a more specific filter. */
+	struct FilterResult {
+		char * pattern;
+		boost::uint32_t types; /* bit mask of the enabled type filters */
+		long long int minSize;
+		long long int maxSize;
+		std::vector<SymbolRow> rows;
+	};
+	
+	typedef std::vector<FilterResult *> FilterStack;
+	
+	/** Complete search result for instant reuse by the same search. */
+	struct CachedResult {
+		char * pattern;
+		boost::uint32_t types; /* bit mask of the enabled type filters */
+		long long int minSize;
+		long long int maxSize;
+		size_t generation; /* symbol list generation */
+		bool query; /* pattern is a query with several terms */
+		std::vector<SymbolRow> rows;
+		Statistics total;
+		Statistics typeStats[27];
+		std::vector<Statistics> memberStats;
+	};
+	
+	typedef std::vector<CachedResult *> ResultCache;
+	
+	struct Query;
+	
+	/** Data shared by all rows of a table. */
+	struct ViewContext {
+		Statistics total;
+		const MemberList * members;
+		const SymbolList * symbols; /* symbols referenced by SymbolRow */
+		LazyDemangler * demangler; /* demangles the displayed names on demand or NULL */
 		
-		~Symbol() {
-			if (this->name != NULL) free(this->name);
-		}
+		explicit ViewContext(const MemberList * aMembers = NULL):
+			total('_'),
+			members(aMembers),
+			symbols(NULL),
+			demangler(NULL)
+		{}
 		
-		Symbol & operator= (const Symbol & o) {
-			if (this != &o) {
-				this->type = o.type;
-				this->size = o.size;
-				this->name = strdup(o.name);
-			}
-			return *this;
+		const char * member(const int index) const {
+			if (this->members == NULL || index < 0 || size_t(index) >= this->members->size()) return NULL;
+			return (*(this->members))[size_t(index)];
 		}
-		
-		const char * operator() (const size_t i, const Statistics & userData) const;
 	};
-	typedef std::vector<Symbol> SymbolList;
 private:
 	char                    * baseLabel;
 	SymbolList                symbolList;
+	MemberList                memberList;
+	SymbolList                nextSymbolList; /* collects a reload until complete */
+	MemberList                nextMemberList;
 	DroppableReadOnlyInput  * nmPath;
 	Fl_Button               * browseNm;
 	DroppableReadOnlyInput  * binPath;
 	Fl_Button               * browseBin;
+	Fl_Button               * cancelLoad;
 	Fl_Input                * pattern;
+	Fl_Input                * sizeRange;
 	Fl_Button               * info;
 	Fl_Table_Row            * stats;
 	Fl_Table_Row            * symbols;
@@ -95,9 +139,27 @@ private:
 	Fl_Native_File_Chooser  * chooseBin;
 	LicenseInfoWindow       * licenseWin;
 	TypeFilterPopup         * typeFilter;
+	SymbolLoader            * loader;
+	FileWatcher             * watcher;
+	LazyDemangler           * lazyDemangler; /* NULL unless demangling on demand */
+	TrigramIndex            * nameIndex; /* speeds up the search in large symbol lists */
+	TypeBuckets             * typeBuckets; /* symbols by type for filters without search pattern */
+	WorkerPool              * filterPool; /* threads filtering the symbols of a search */
+	Query                   * query; /* search running in the background or NULL */
+	size_t                    queryGeneration; /* incremented with each search; only the latest updates the tables */
+	double                    searchDelay; /* seconds to wait for further pattern changes before searching */
+	size_t                    topSymbols; /* maximum number of shown symbols or 0 for all */
+	FilterStack               filterStack; /* previous filter results; most specific last */
+	ResultCache               resultCache; /* recent complete search results; least recently used first */
+	size_t                    symbolGeneration; /* incremented with each change of the symbol list */
+	size_t                    loadId;
+	bool                      reloading; /* keep the current lists until the load completes? */
 	char                    * currentNm;
 	char                    * currentBin;
+	char                    * cacheDir;
 	bool                      demangleSymbols;
+	bool                      nativeReader;
+	bool                      ignoreCase;
 public:
 	explicit SymbolViewer(const int W, const int H, const char * L = NULL);
 	virtual ~SymbolViewer();
@@ -115,6 +177,7 @@ private:
 	PCF_GUI_BIND(SymbolViewer, onChangeNm, Fl_Input)
 	PCF_GUI_BIND(SymbolViewer, onBrowseBin, Fl_Button)
 	PCF_GUI_BIND(SymbolViewer, onChangeBin, Fl_Input)
+	PCF_GUI_BIND(SymbolViewer, onCancelLoad, Fl_Button)
 	PCF_GUI_BIND(SymbolViewer, onInformation, Fl_Button)
 	PCF_GUI_BIND(SymbolViewer, onChangePattern, Fl_Input)
 	PCF_GUI_BIND(SymbolViewer, onTableEvent, Fl_Table_Row)
@@ -123,12 +186,34 @@ private:
 	void onChangeNm(Fl_Input * input);
 	void onBrowseBin(Fl_Button * button);
 	void onChangeBin(Fl_Input * input);
+	void onCancelLoad(Fl_Button * button);
 	void onInformation(Fl_Button * button);
 	void onChangePattern(Fl_Input * input);
 	void onTableEvent(Fl_Table_Row * table);
 	
-	void read(const bool force = false);
-	void update();
+	static void onLoadBatch(void * data);
+	static void onFileChange(void * data);
+	static void onDemangled(void * data);
+	static void onSearchDelay(void * data);
+	static void onQueryRows(void * data);
+	static void onQueryDone(void * data);
+	static void queryMain(void * param);
+	static void runQuery(Query & q);
+	
+	void read(const bool force = false, const bool reload = false);
+	void cancel();
+	void showLoading(const bool loading);
+	void resetDemangling();
+	void demangleAll();
+	void buildIndex();
+	void clearFilters();
+	bool loadResult(Query & q);
+	void storeResult(const Query & q);
+	void clearResults();
+	static void clearMembers(MemberList & list);
+	void cancelQuery();
+	void update(const bool background = false);
+	void applyQuery(Query & q);
 };
 
 
@@ -0,0 +1,309 @@
+/**
+ * @file TrigramIndex.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ * @remarks Trigrams are hashed into a fixed number of posting lists. Each list
+ * holds the ascending indices of the symbols containing one of its trigrams as
+ * differences to the previous index with 7 bits per byte. Hash collisions only
+ * add candidates which are removed by the exact match afterwards.
+ */
+#include <algorithm>
+#include <utility>
+#include <pcf/gui/TrigramIndex.hpp>
+
+
+namespace pcf {
+namespace gui {
+namespace {
+
+
+/** Number of bits of the posting list number. */
+static const unsigned BUCKET_BITS = 18;
+/** Number of posting lists. */
+static const size_t BUCKETS = size_t(1) << BUCKET_BITS;
+/** Number of symbols indexed between two cancellation checks. */
+static const size_t CHUNK_SIZE = 0x4000;
+/**
+ * Posting lists with more bytes than this factor times the number of
+ * remaining candidates are not intersected. Checking these candidates
+ * directly is faster then.
+ */
+static const size_t INTERSECT_LIMIT = 64;
+
+
+/**
+ * Returns the posting list of the trigram at the given position. ASCII
+ * letters are indexed in lower case to serve case-insensitive searches, too.
+ *
+ * @param[in] str - trigram position (needs 3 characters)
+ * @return posting list number
+ */
+inline size_t bucketOf(const char * str) {
+	boost::uint32_t trigram = 0;
+	for (size_t n = 0; n < 3; n++) {
+		const unsigned char c = static_cast<unsigned char>(str[n]);
+		trigram = (trigram << 8) | boost::uint32_t((c >= 'A' && c <= 'Z') ? (c | 0x20) : c);
+	}
+	return size_t((trigram * 0x9E3779B1U) >> (32 - BUCKET_BITS));
+}
+
+
+/**
+ * Returns the number of bytes needed to store the given value.
+ *
+ * @param[in] value - value to store
+ * @return number of bytes
+ */
+inline size_t varintSize(boost::uint32_t value) {
+	size_t result = 1;
+	for (; value >= 0x80; value >>= 7) result++;
+	return result;
+}
+
+
+/**
+ * Stores the given value with 7 bits per byte. The highest bit marks that
+ * more bytes follow.
+ *
+ * @param[out] out - output position
+ * @param[in] value - value to store
+ * @return next output position
+ */
+inline unsigned char * putVarint(unsigned char * out, boost::uint32_t value) {
+	for (; value >= 0x80; value >>= 7) *out++ = static_cast<unsigned char>(value | 0x80);
+	*out++ = static_cast<unsigned char>(value);
+	return out;
+}
+
+
+/**
+ * Reads a value stored by putVarint().
+ *
+ * @param[in] in - input position
+ * @param[out] value - read value
+ * @return next input position
+ */
+inline const unsigned char * getVarint(const unsigned char * in, boost::uint32_t & value) {
+	value = 0;
+	for (unsigned shift = 0; ; shift += 7) {
+		const unsigned char c = *in++;
+		value |= boost::uint32_t(c & 0x7F) << shift;
+		if ((c & 0x80) == 0) return in;
+	}
+}
+
+
+/**
+ * Checks whether the given character is a wildcard of the search pattern.
+ *
+ * @param[in] c - character
+ * @return true if wildcard, else false
+ */
+inline bool isWildcard(const char c) {
+	return c == '*' || c == '?' || c == '#';
+}
+
+
+} /* anonymous namespace */
+
+
+/**
+ * Constructor.
+ */
+TrigramIndex::TrigramIndex():
+	thread(NULL),
+	cancelled(0),
+	finished(0),
+	ready(false),
+	list(NULL)
+{}
+
+
+/**
+ * Destructor. Stops building in the background.
+ */
+TrigramIndex::~TrigramIndex() {
+	this->clear();
+}
+
+
+/**
+ * Starts to build the index for the given symbol list in the background. The
+ * list may not be changed until clear() was called.
+ *
+ * @param[in] aList - symbol list
+ * @return true on success, false if already built or running or on error
+ */
+bool TrigramIndex::build(const SymbolList & aList) {
+	if (this->thread != NULL || this->list != NULL) return false;
+	this->list = &aList;
+	this->cancelled = 0;
+	this->finished = 0;
+	this->thread = thread_create(TrigramIndex::buildMain, this);
+	return this->thread != NULL;
+}
+
+
+/**
+ * Checks whether the index of the given symbol list can be used.
+ *
+ * @param[in] aList - symbol list
+ * @return true if built for this list, else false
+ */
+bool TrigramIndex::isReady(const SymbolList & aList) {
+	if (this->thread != NULL && __atomic_load_n(&(this->finished), __ATOMIC_ACQUIRE) != 0) {
+		thread_join(this->thread);
+		this->thread = NULL;
+		this->ready = ! this->heads.empty();
+	}
+	return this->ready && this->list == &aList;
+}
+
+
+/**
+ * Returns the symbols which may match the given search pattern. These contain
+ * all trigrams within the parts of the pattern without wildcards, regardless
+ * of their case.
+ *
+ * @param[in] pattern - search pattern
+ * @param[out] rows - receives the ascending candidate symbol indices
+ * @return true on success, false if the index is not ready or cannot narrow the search
+ */
+bool TrigramIndex::find(const char * pattern, std::vector<boost::uint32_t> & rows) const {
+	rows.clear();
+	if (( ! this->ready ) || pattern == NULL) return false;
+	std::vector<size_t> buckets;
+	for (const char * run = pattern; *run != 0; ) {
+		if ( isWildcard(*run) ) {
+			run++;
+			continue;
+		}
+		const char * end = run;
+		while (*end != 0 && ( ! isWildcard(*end) )) end++;
+		for (const char * pos = run; (pos + 3) <= end; pos++) buckets.push_back(bucketOf(pos));
+		run = end;
+	}
+	if ( buckets.empty() ) return false;
+	std::sort(buckets.begin(), buckets.end());
+	buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+	/* intersect the shortest posting lists first */
+	std::vector< std::pair<size_t, size_t> > lists; /* size, bucket */
+	lists.reserve(buckets.size());
+	for (std::vector<size_t>::const_iterator it = buckets.begin(); it != buckets.end(); ++it) {
+		lists.push_back(std::make_pair(this->heads[*it + 1] - this->heads[*it], *it));
+	}
+	std::sort(lists.begin(), lists.end());
+	if (lists.front().first == 0) return true;
+	/* a dense posting list references almost every symbol */
+	if (lists.front().first >= this->list->size()) return false;
+	for (size_t n = 0; n < lists.size(); n++) {
+		const unsigned char * in = &(this->postings[this->heads[lists[n].second]]);
+		const unsigned char * end = in + lists[n].first;
+		boost::uint32_t row = 0; /* symbol index plus one */
+		boost::uint32_t delta;
+		if (n == 0) {
+			while (in < end) {
+				in = getVarint(in, delta);
+				row += delta;
+				rows.push_back(row - 1);
+			}
+			continue;
+		}
+		if (rows.empty() || lists[n].first > (rows.size() * INTERSECT_LIMIT)) break;
+		size_t out = 0;
+		size_t k = 0;
+		while (in < end && k < rows.size()) {
+			in = getVarint(in, delta);
+			row += delta;
+			while (k < rows.size() && rows[k] < (row - 1)) k++;
+			if (k < rows.size() && rows[k] == (row - 1)) rows[out++] = rows[k++];
+		}
+		rows.resize(out);
+	}
+	return true;
+}
+
+
+/**
+ * Stops building in the background and frees the index.
+ */
+void TrigramIndex::clear() {
+	if (this->thread != NULL) {
+		__atomic_store_n(&(this->cancelled), 1, __ATOMIC_RELEASE);
+		thread_join(this->thread);
+		this->thread = NULL;
+	}
+	std::vector<size_t>().swap(this->heads);
+	std::vector<unsigned char>().swap(this->postings);
+	this->ready = false;
+	this->list = NULL;
+}
+
+
+/**
+ * Background thread function.
+ *
+ * @param[in,out] param - pointer to TrigramIndex
+ */
+void TrigramIndex::buildMain(void * param) {
+	TrigramIndex * self = static_cast<TrigramIndex *>(param);
+	if ( ! self->index() ) {
+		std::vector<size_t>().swap(self->heads);
+		std::vector<unsigned char>().swap(self->postings);
+	}
+	__atomic_store_n(&(self->finished), 1, __ATOMIC_RELEASE);
+}
+
+
+/**
+ * Builds the index in two passes. The first one determines the size of each
+ * posting list and the second one fills them.
+ *
+ * @return true on success, false if cancelled or on error
+ */
+bool TrigramIndex::index() {
+	const SymbolList & symbols = *(this->list);
+	const size_t count = symbols.size();
+	if (count >= size_t(0xFFFFFFFF)) return false;
+	std::vector<boost::uint32_t> last(BUCKETS, 0); /* last added symbol index plus one */
+	std::vector<size_t> pos(BUCKETS + 1, 0);
+	for (int pass = 0; pass < 2; pass++) {
+		if (pass == 1) {
+			/* posting list start positions */
+			this->heads.resize(BUCKETS + 1);
+			size_t total = 0;
+			for (size_t b = 0; b <= BUCKETS; b++) {
+				this->heads[b] = total;
+				total += pos[b];
+			}
+			this->postings.resize(total);
+			std::copy(this->heads.begin(), this->heads.end(), pos.begin());
+			std::fill(last.begin(), last.end(), 0);
+		}
+		for (size_t first = 0; first < count; first += CHUNK_SIZE) {
+			if (__atomic_load_n(&(this->cancelled), __ATOMIC_ACQUIRE) != 0) return false;
+			const size_t chunkEnd = first + std::min(CHUNK_SIZE, count - first);
+			for (size_t i = first; i < chunkEnd; i++) {
+				const boost::uint32_t row = boost::uint32_t(i + 1);
+				for (const char * name = symbols.getName(i); name[0] != 0 && name[1] != 0 && name[2] != 0; name++) {
+					const size_t b = bucketOf(name);
+					if (last[b] == row) continue; /* already added for this symbol */
+					if (pass == 0) {
+						pos[b] += varintSize(row - last[b]);
+					} else {
+						unsigned char * out = &(this->postings[pos[b]]);
+						pos[b] += size_t(putVarint(out, row - last[b]) - out);
+					}
+					last[b] = row;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+
+} /* namespace gui */
+} /* namespace pcf */
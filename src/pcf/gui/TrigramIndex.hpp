@@ -0,0 +1,63 @@
+/**
+ * @file TrigramIndex.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __PCF_GUI_TRIGRAMINDEX_HPP__
+#define __PCF_GUI_TRIGRAMINDEX_HPP__
+
+#include <vector>
+#include <pcf/gui/SymbolList.hpp>
+
+
+extern "C" {
+#include <libpcf/thread.h>
+}
+
+
+namespace pcf {
+namespace gui {
+
+
+/**
+ * Trigram index over the symbol names of a symbol list. Each trigram of a
+ * name (ASCII letters in lower case) references the symbol in a posting list.
+ * Intersecting the posting lists of all trigrams within the literal parts of
+ * a search pattern gives a superset of the matching symbols. The index is
+ * built in the background and only valid until the symbol list changes.
+ */
+class TrigramIndex {
+private:
+	tThread * thread;
+	volatile int cancelled;
+	volatile int finished;
+	bool ready;
+	const SymbolList * list; /* indexed symbols */
+	std::vector<size_t> heads; /* posting list start per bucket plus end */
+	std::vector<unsigned char> postings; /* ascending symbol indices as variable length deltas */
+public:
+	explicit TrigramIndex();
+	~TrigramIndex();
+
+	bool build(const SymbolList & aList);
+	bool isBuilding() const { return this->thread != NULL; }
+	bool isReady(const SymbolList & aList);
+	bool find(const char * pattern, std::vector<boost::uint32_t> & rows) const;
+	void clear();
+private:
+	TrigramIndex(const TrigramIndex &);
+	TrigramIndex & operator= (const TrigramIndex &);
+
+	static void buildMain(void * param);
+
+	bool index();
+};
+
+
+} /* namespace gui */
+} /* namespace pcf */
+
+
+#endif /* __PCF_GUI_TRIGRAMINDEX_HPP__ */
@@ -0,0 +1,200 @@
+/**
+ * @file TypeBuckets.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ * @remarks The selected buckets are merged via a heap over the next symbol
+ * index of each bucket. If the selected buckets hold most of the requested
+ * symbols, checking the type column of each symbol against a lookup table is
+ * faster and gives the same result.
+ */
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <pcf/gui/TypeBuckets.hpp>
+
+
+namespace pcf {
+namespace gui {
+namespace {
+
+
+/** Number of merged symbols between two cancellation checks. */
+static const size_t CHUNK_SIZE = 0x4000;
+/**
+ * The type column is checked directly if the selected buckets hold at least
+ * the requested symbols divided by this factor.
+ */
+static const size_t SCAN_FACTOR = 4;
+
+
+/**
+ * Checks whether the given search was cancelled.
+ *
+ * @param[in] cancelled - cancellation flag or NULL
+ * @return true if cancelled, else false
+ */
+inline bool isCancelled(const volatile int * cancelled) {
+	return cancelled != NULL && __atomic_load_n(cancelled, __ATOMIC_ACQUIRE) != 0;
+}
+
+
+} /* anonymous namespace */
+
+
+/**
+ * Constructor.
+ */
+TypeBuckets::TypeBuckets():
+	list(NULL)
+{}
+
+
+/**
+ * Returns the bucket of the given symbol type. Upper case letters are global
+ * and lower case letters local symbols.
+ *
+ * @param[in] type - symbol type as reported by nm
+ * @return bucket number
+ */
+size_t TypeBuckets::bucketOf(const char type) {
+	if (type >= 'A' && type <= 'Z') return size_t(GLOBAL + (type - 'A'));
+	if (type >= 'a' && type <= 'z') return size_t(LOCAL + (type - 'a'));
+	if (type == '?') return size_t(UNKNOWN);
+	return size_t(OTHER);
+}
+
+
+/**
+ * Partitions the given symbol list. The list may not be changed until clear()
+ * was called.
+ *
+ * @param[in] aList - symbol list
+ */
+void TypeBuckets::build(const SymbolList & aList) {
+	this->clear();
+	const std::vector<char> & types = aList.getTypes();
+	const std::vector<long long int> & sizes = aList.getSizes();
+	const std::vector<int> & members = aList.getMembers();
+	const size_t count = aList.size();
+	if (count >= size_t(0xFFFFFFFF)) return;
+	/* count first to allocate each bucket once */
+	size_t counts[COUNT] = {0};
+	size_t memberCount = 0;
+	for (size_t i = 0; i < count; i++) {
+		counts[bucketOf(types[i])]++;
+		if (members[i] >= 0) memberCount = std::max(memberCount, size_t(members[i]) + 1);
+	}
+	for (size_t n = 0; n < COUNT; n++) this->buckets[n].rows.reserve(counts[n]);
+	std::vector<MemberTotals> memberTotals(COUNT * memberCount); /* per bucket and member */
+	for (size_t i = 0; i < count; i++) {
+		const size_t b = bucketOf(types[i]);
+		Bucket & bucket = this->buckets[b];
+		const long long int size = sizes[i];
+		bucket.rows.push_back(boost::uint32_t(i));
+		bucket.size += size;
+		if (size > 0) bucket.positiveSize += size;
+		if (members[i] >= 0) {
+			MemberTotals & totals = memberTotals[(b * memberCount) + size_t(members[i])];
+			totals.size += size;
+			totals.symbols++;
+		}
+	}
+	for (size_t b = 0; b < COUNT; b++) {
+		for (size_t m = 0; m < memberCount; m++) {
+			MemberTotals & totals = memberTotals[(b * memberCount) + m];
+			if (totals.symbols <= 0) continue;
+			totals.member = int(m);
+			this->buckets[b].members.push_back(totals);
+		}
+	}
+	this->list = &aList;
+}
+
+
+/**
+ * Merges the symbols of the selected buckets within the given symbol index
+ * range in ascending order.
+ *
+ * @param[in] selected - selected buckets (COUNT elements)
+ * @param[in] first - first symbol index
+ * @param[in] last - symbol index after the last one
+ * @param[in] limit - maximum number of symbols or 0 for all
+ * @param[out] rows - receives the ascending symbol indices
+ * @param[in] cancelled - stops merging once set to non-zero (may be NULL)
+ * @return true on success, false if cancelled or not built
+ */
+bool TypeBuckets::merge(const bool * selected, const size_t first, const size_t last, const size_t limit, std::vector<boost::uint32_t> & rows, const volatile int * cancelled) const {
+	typedef std::vector<boost::uint32_t>::const_iterator Iterator;
+	rows.clear();
+	if (this->list == NULL || selected == NULL) return false;
+	if (first >= last) return true;
+	/* range of each selected bucket */
+	std::vector< std::pair<Iterator, Iterator> > ranges;
+	size_t total = 0;
+	for (size_t n = 0; n < COUNT; n++) {
+		if ( ! selected[n] ) continue;
+		const std::vector<boost::uint32_t> & bucketRows = this->buckets[n].rows;
+		const Iterator from = std::lower_bound(bucketRows.begin(), bucketRows.end(), boost::uint32_t(first));
+		const Iterator to = std::lower_bound(from, bucketRows.end(), boost::uint32_t(last));
+		if (from == to) continue;
+		ranges.push_back(std::make_pair(from, to));
+		total += size_t(to - from);
+	}
+	const size_t wanted = (limit > 0) ? std::min(limit, total) : total;
+	rows.reserve(wanted);
+	if (ranges.size() == 1) {
+		rows.assign(ranges[0].first, ranges[0].first + std::ptrdiff_t(wanted));
+		return true;
+	}
+	if ((total * SCAN_FACTOR) >= (last - first)) {
+		/* most symbols are selected */
+		bool take[256];
+		for (size_t c = 0; c < 256; c++) take[c] = selected[bucketOf(char(c))];
+		const std::vector<char> & types = this->list->getTypes();
+		for (size_t i = first; i < last && rows.size() < wanted; i++) {
+			if ((i % CHUNK_SIZE) == 0 && isCancelled(cancelled)) return false;
+			if ( take[static_cast<unsigned char>(types[i])] ) rows.push_back(boost::uint32_t(i));
+		}
+		return true;
+	}
+	/* min-heap of the next symbol index per bucket */
+	typedef std::pair<boost::uint32_t, size_t> Entry; /* symbol index, range */
+	std::vector<Entry> heap;
+	heap.reserve(ranges.size());
+	for (size_t n = 0; n < ranges.size(); n++) heap.push_back(Entry(*(ranges[n].first), n));
+	std::make_heap(heap.begin(), heap.end(), std::greater<Entry>());
+	while (rows.size() < wanted) {
+		if ((rows.size() % CHUNK_SIZE) == 0 && isCancelled(cancelled)) return false;
+		std::pop_heap(heap.begin(), heap.end(), std::greater<Entry>());
+		Entry & next = heap.back();
+		rows.push_back(next.first);
+		std::pair<Iterator, Iterator> & range = ranges[next.second];
+		if (++(range.first) == range.second) {
+			heap.pop_back();
+		} else {
+			next.first = *(range.first);
+			std::push_heap(heap.begin(), heap.end(), std::greater<Entry>());
+		}
+	}
+	return true;
+}
+
+
+/**
+ * Frees all buckets.
+ */
+void TypeBuckets::clear() {
+	for (size_t n = 0; n < COUNT; n++) {
+		std::vector<boost::uint32_t>().swap(this->buckets[n].rows);
+		std::vector<MemberTotals>().swap(this->buckets[n].members);
+		this->buckets[n].size = 0;
+		this->buckets[n].positiveSize = 0;
+	}
+	this->list = NULL;
+}
+
+
+} /* namespace gui */
+} /* namespace pcf */
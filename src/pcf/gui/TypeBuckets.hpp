@@ -0,0 +1,83 @@
+/**
+ * @file TypeBuckets.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __PCF_GUI_TYPEBUCKETS_HPP__
+#define __PCF_GUI_TYPEBUCKETS_HPP__
+
+#include <vector>
+#include <pcf/gui/SymbolList.hpp>
+
+
+namespace pcf {
+namespace gui {
+
+
+/**
+ * Partitions the symbols of a symbol list by type and scope. Each bucket
+ * keeps its symbols in list order (i.e. by size in descending order) and the
+ * totals of its symbols. The symbols of any combination of type filters are
+ * obtained by merging the selected buckets without checking each symbol.
+ */
+class TypeBuckets {
+public:
+	enum {
+		GLOBAL = 0, /**< first global type bucket (A to Z) */
+		LOCAL = 26, /**< first local type bucket (a to z) */
+		UNKNOWN = 52, /**< type '?' */
+		OTHER = 53, /**< any other type */
+		COUNT = 54 /**< number of buckets */
+	};
+
+	/** Totals of the symbols of one archive member within a bucket. */
+	struct MemberTotals {
+		int member;
+		long long int size;
+		size_t symbols;
+
+		explicit MemberTotals(const int aMember = -1):
+			member(aMember),
+			size(0),
+			symbols(0)
+		{}
+	};
+
+	/** Symbols of one type and scope. */
+	struct Bucket {
+		std::vector<boost::uint32_t> rows; /* ascending symbol indices */
+		long long int size; /* sum of all sizes */
+		long long int positiveSize; /* sum of all positive sizes */
+		std::vector<MemberTotals> members; /* in ascending member order; only members with symbols */
+
+		explicit Bucket():
+			size(0),
+			positiveSize(0)
+		{}
+	};
+private:
+	const SymbolList * list; /* partitioned symbols */
+	Bucket buckets[COUNT];
+public:
+	explicit TypeBuckets();
+
+	static size_t bucketOf(const char type);
+
+	void build(const SymbolList & aList);
+	bool isReady(const SymbolList & aList) const { return this->list == &aList; }
+	const Bucket & getBucket(const size_t n) const { return this->buckets[n]; }
+	bool merge(const bool * selected, const size_t first, const size_t last, const size_t limit, std::vector<boost::uint32_t> & rows, const volatile int * cancelled = NULL) const;
+	void clear();
+private:
+	TypeBuckets(const TypeBuckets &);
+	TypeBuckets & operator= (const TypeBuckets &);
+};
+
+
+} /* namespace gui */
+} /* namespace pcf */
+
+
+#endif /* __PCF_GUI_TYPEBUCKETS_HPP__ */
@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2017-2023 Daniel Starke
  * @date 2017-04-10
- * @version 2017-10-15
+ * @version 2026-10-16
  */
 #include <cmath>
 #include <cstdlib>
@@ -12,6 +12,11 @@
 #include <pcf/gui/Utility.hpp>
 
 
+extern "C" {
+#include <libpcf/thread.h>
+}
+
+
 /** Defines the maximum number of available screen resolutions (derived from FLTK). */
 #define MAX_SCREENS_RES 16
 
@@ -133,5 +138,24 @@ int adjDpiV(const int val, const int screen) {
 }
 
 
+/**
+ * Calls the given handler within the GUI thread via Fl::awake(). Retries
+ * while the message queue is full.
+ * 
+ * @param[in] handler - handler to call
+ * @param[in] data - handler argument
+ * @param[in] cancelled - stops retrying once set to non-zero (may be NULL)
+ * @return true on success, false if cancelled
+ */
+bool awake(Fl_Awake_Handler handler, void * data, const volatile int * cancelled) {
+	while (Fl::awake(handler, data) != 0) {
+		/* message queue is full */
+		if (cancelled != NULL && __atomic_load_n(cancelled, __ATOMIC_ACQUIRE) != 0) return false;
+		thread_sleep(10);
+	}
+	return true;
+}
+
+
 } /* namespace gui */
 } /* namespace pcf */
@@ -3,7 +3,7 @@
  * @author Daniel Starke
  * @copyright Copyright 2017-2023 Daniel Starke
  * @date 2017-04-10
- * @version 2017-12-01
+ * @version 2026-10-16
  */
 #ifndef __PCF_GUI_UTILITY_HPP__
 #define __PCF_GUI_UTILITY_HPP__
@@ -47,6 +47,7 @@ void noSymLabelDraw(const Fl_Label * o, int X, int Y, int W, int H, Fl_Align ali
 void noSymLabelMeasure(const Fl_Label * o, int & W, int & H);
 int adjDpiH(const int val, const int screen = 0);
 int adjDpiV(const int val, const int screen = 0);
+bool awake(Fl_Awake_Handler handler, void * data, const volatile int * cancelled);
 
 
 /**
@@ -0,0 +1,132 @@
+/**
+ * @file WorkerPool.cpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#include <pcf/gui/WorkerPool.hpp>
+
+
+namespace pcf {
+namespace gui {
+
+
+/**
+ * Constructor. Starts the worker threads. The pool falls back to run all
+ * parameters in the calling thread if the synchronization objects or threads
+ * could not be created.
+ *
+ * @param[in] aThreads - number of threads including the calling thread (0 for one per CPU)
+ */
+WorkerPool::WorkerPool(const size_t aThreads):
+	mutex(thread_mutexCreate()),
+	wake(thread_conditionCreate()),
+	idle(thread_conditionCreate()),
+	function(NULL),
+	params(NULL),
+	count(0),
+	next(0),
+	active(0),
+	generation(0),
+	stop(false)
+{
+	if (this->mutex == NULL || this->wake == NULL || this->idle == NULL) return;
+	const size_t threadCount = (aThreads > 0) ? aThreads : thread_cpuCount();
+	for (size_t i = 1; i < threadCount; i++) {
+		tThread * thread = thread_create(WorkerPool::workerMain, this);
+		if (thread == NULL) break;
+		this->threads.push_back(thread);
+	}
+}
+
+
+/**
+ * Destructor. Stops the worker threads.
+ */
+WorkerPool::~WorkerPool() {
+	thread_mutexLock(this->mutex);
+	this->stop = true;
+	thread_conditionBroadcast(this->wake);
+	thread_mutexUnlock(this->mutex);
+	for (std::vector<tThread *>::iterator it = this->threads.begin(); it != this->threads.end(); ++it) {
+		thread_join(*it);
+	}
+	thread_conditionFree(this->idle);
+	thread_conditionFree(this->wake);
+	thread_mutexFree(this->mutex);
+}
+
+
+/**
+ * Runs the given function once for each parameter in parallel and waits for
+ * all calls to return. Each thread including the calling one processes
+ * parameters until none are left.
+ *
+ * @param[in] aFunction - function to run
+ * @param[in] aParams - function parameters
+ * @param[in] aCount - number of parameters
+ */
+void WorkerPool::run(Function aFunction, void * const * aParams, const size_t aCount) {
+	if (aFunction == NULL || aParams == NULL || aCount == 0) return;
+	if ( this->threads.empty() ) {
+		for (size_t i = 0; i < aCount; i++) aFunction(aParams[i]);
+		return;
+	}
+	thread_mutexLock(this->mutex);
+	this->function = aFunction;
+	this->params = aParams;
+	this->count = aCount;
+	this->next = 0;
+	this->generation++;
+	if (aCount > 1) thread_conditionBroadcast(this->wake);
+	this->process();
+	while (this->active > 0) thread_conditionWait(this->idle, this->mutex);
+	this->function = NULL;
+	this->params = NULL;
+	this->count = 0;
+	thread_mutexUnlock(this->mutex);
+}
+
+
+/**
+ * Processes the parameters of the current run until none are left. The
+ * mutex needs to be locked by the caller.
+ */
+void WorkerPool::process() {
+	while (this->next < this->count) {
+		const Function func = this->function;
+		void * param = this->params[this->next];
+		this->next++;
+		this->active++;
+		thread_mutexUnlock(this->mutex);
+		func(param);
+		thread_mutexLock(this->mutex);
+		this->active--;
+	}
+	if (this->active == 0) thread_conditionBroadcast(this->idle);
+}
+
+
+/**
+ * Worker thread function. Waits for new runs and takes part in them until
+ * the pool gets destroyed.
+ *
+ * @param[in,out] param - pointer to WorkerPool
+ */
+void WorkerPool::workerMain(void * param) {
+	WorkerPool * self = static_cast<WorkerPool *>(param);
+	thread_mutexLock(self->mutex);
+	size_t seen = self->generation;
+	for (;;) {
+		while (( ! self->stop ) && seen == self->generation) thread_conditionWait(self->wake, self->mutex);
+		if ( self->stop ) break;
+		seen = self->generation;
+		self->process();
+	}
+	thread_mutexUnlock(self->mutex);
+}
+
+
+} /* namespace gui */
+} /* namespace pcf */
@@ -0,0 +1,66 @@
+/**
+ * @file WorkerPool.hpp
+ * @author Daniel Starke
+ * @copyright Copyright 2026 Daniel Starke
+ * @date 2026-10-16
+ * @version 2026-10-16
+ */
+#ifndef __PCF_GUI_WORKERPOOL_HPP__
+#define __PCF_GUI_WORKERPOOL_HPP__
+
+#include <cstddef>
+#include <vector>
+
+
+extern "C" {
+#include <libpcf/thread.h>
+}
+
+
+namespace pcf {
+namespace gui {
+
+
+/**
+ * Pool of worker threads which are started once and run a function for a
+ * set of parameters in parallel. The calling thread takes part in each run.
+ * Idle workers block until the next run. Only one thread may call run() at a
+ * time.
+ */
+class WorkerPool {
+public:
+	/** Function run for each parameter. */
+	typedef void (*Function)(void * param);
+private:
+	std::vector<tThread *> threads;
+	tMutex * mutex; /* guards all members below */
+	tCondition * wake; /* signaled on new runs and on destruction */
+	tCondition * idle; /* signaled once the last parameter was processed */
+	Function function; /* function of the current run */
+	void * const * params; /* parameters of the current run */
+	size_t count; /* number of parameters of the current run */
+	size_t next; /* next parameter to process */
+	size_t active; /* number of parameters being processed */
+	size_t generation; /* incremented for each run */
+	bool stop; /* set to terminate the worker threads */
+public:
+	explicit WorkerPool(const size_t aThreads = 0);
+	~WorkerPool();
+
+	/** @return number of threads including the calling thread */
+	size_t size() const { return this->threads.size() + 1; }
+	void run(Function aFunction, void * const * aParams, const size_t aCount);
+private:
+	WorkerPool(const WorkerPool &);
+	WorkerPool & operator= (const WorkerPool &);
+
+	void process();
+	static void workerMain(void * param);
+};
+
+
+} /* namespace gui */
+} /* namespace pcf */
+
+
+#endif /* __PCF_GUI_WORKERPOOL_HPP__ */